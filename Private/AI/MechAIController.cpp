@@ -0,0 +1,237 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/MechAIController.h"
+#include "AI/MechBoostJumpLink.h"
+#include "AI/MechPathBatchSubsystem.h"
+#include "AI/NavFilter_MechNoBoostJump.h"
+#include "Characters/PlayerMech.h"
+#include "Components/MechMovementComponent.h"
+#include "Data/MechTuningData.h"
+#include "NavLinkCustomComponent.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "TimerManager.h"
+
+AMechAIController::AMechAIController()
+{
+	NoBoostJumpFilterClass = UNavFilter_MechNoBoostJump::StaticClass();
+}
+
+APlayerMech* AMechAIController::GetMech() const
+{
+	return Cast<APlayerMech>(GetPawn());
+}
+
+void AMechAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	if (APlayerMech* Mech = GetMech())
+	{
+		Mech->LandedDelegate.AddDynamic(this, &AMechAIController::HandleLanded);
+	}
+
+	GetWorldTimerManager().SetTimer(BoostUpdateTimer, this, &AMechAIController::UpdateBoost, BoostUpdateInterval, true);
+}
+
+void AMechAIController::OnUnPossess()
+{
+	if (APlayerMech* Mech = GetMech())
+	{
+		Mech->LandedDelegate.RemoveDynamic(this, &AMechAIController::HandleLanded);
+		Mech->SetBoostRequested(false);
+		Mech->GetMechMovement()->SetBoostJumping(false);
+
+		if (UMechPathBatchSubsystem* PathBatch = GetWorld()->GetSubsystem<UMechPathBatchSubsystem>())
+		{
+			PathBatch->CancelRequests(Mech);
+		}
+	}
+
+	GetWorldTimerManager().ClearTimer(BoostUpdateTimer);
+	GetWorldTimerManager().ClearTimer(BoostJumpRetryTimer);
+	GetWorldTimerManager().ClearTimer(PathRetryTimer);
+	ActiveBoostJumpLink.Reset();
+	bHasMoveGoal = false;
+
+	Super::OnUnPossess();
+}
+
+TSubclassOf<UNavigationQueryFilter> AMechAIController::ChoosePathFilter() const
+{
+	// Link costs already scale with energy; a mech whose generator never refills would wait at them forever
+	const APlayerMech* Mech = GetMech();
+	if (Mech && Mech->GetTuning().BoostRegenRate <= 0.f)
+	{
+		return NoBoostJumpFilterClass;
+	}
+
+	return DefaultNavigationFilterClass;
+}
+
+void AMechAIController::MoveToLocationBatched(const FVector& Goal)
+{
+	MoveGoal = Goal;
+	bHasMoveGoal = true;
+	NumPathRetries = 0;
+	GetWorldTimerManager().ClearTimer(PathRetryTimer);
+
+	RequestBatchedPath(Goal, ChoosePathFilter());
+}
+
+void AMechAIController::RequestBatchedPath(const FVector& Goal, TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	APlayerMech* Mech = GetMech();
+	UMechPathBatchSubsystem* PathBatch = GetWorld()->GetSubsystem<UMechPathBatchSubsystem>();
+	if (!Mech || !PathBatch)
+	{
+		bHasMoveGoal = false;
+		return;
+	}
+
+	PathBatch->CancelRequests(Mech);
+	PathBatch->RequestPath(Mech, Mech->GetNavAgentLocation(), Goal, FilterClass,
+		FOnMechPathReady::CreateUObject(this, &AMechAIController::HandlePathReady, Goal, FilterClass));
+}
+
+void AMechAIController::HandlePathReady(FNavPathSharedPtr Path, FVector Goal, TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	// A newer goal may have been set while this path was in flight
+	if (!bHasMoveGoal || !MoveGoal.Equals(Goal))
+	{
+		return;
+	}
+
+	if (!Path.IsValid())
+	{
+		// Navmesh may still be streaming in or rebuilding around the bot; give up after a few tries
+		if (NumPathRetries >= MaxPathRetries)
+		{
+			bHasMoveGoal = false;
+			return;
+		}
+
+		++NumPathRetries;
+		GetWorldTimerManager().SetTimer(PathRetryTimer, FTimerDelegate::CreateUObject(this, &AMechAIController::RequestBatchedPath, Goal, FilterClass), PathRetryDelay, false);
+		return;
+	}
+
+	NumPathRetries = 0;
+
+	FAIMoveRequest MoveRequest(Goal);
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+	MoveRequest.SetNavigationFilter(FilterClass);
+	RequestMove(MoveRequest, Path);
+}
+
+void AMechAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+	Super::OnMoveCompleted(RequestID, Result);
+
+	if (Result.IsSuccess())
+	{
+		bHasMoveGoal = false;
+	}
+
+	if (APlayerMech* Mech = GetMech())
+	{
+		Mech->SetBoostRequested(false);
+	}
+}
+
+void AMechAIController::UpdateBoost()
+{
+	APlayerMech* Mech = GetMech();
+	if (!Mech || ActiveBoostJumpLink.IsValid())
+	{
+		return;
+	}
+
+	const bool bMoving = GetMoveStatus() == EPathFollowingStatus::Moving;
+	const bool bLongLeg = bHasMoveGoal && FVector::DistSquared(Mech->GetActorLocation(), MoveGoal) > FMath::Square(BoostDistanceThreshold);
+	const float Reserve = Mech->IsBoosting() ? BoostReserveEnergy : BoostReserveEnergy + Mech->GetTuning().DashEnergyCost;
+
+	Mech->SetBoostRequested(bMoving && bLongLeg && Mech->GetBoostEnergy() > Reserve);
+}
+
+void AMechAIController::BeginBoostJump(AMechBoostJumpLink* Link, const FVector& Destination)
+{
+	APlayerMech* Mech = GetMech();
+	if (!Mech || !Link)
+	{
+		return;
+	}
+
+	GetWorldTimerManager().ClearTimer(BoostJumpRetryTimer);
+	ActiveBoostJumpLink = Link;
+
+	const UMechTuningData& Tuning = Mech->GetTuning();
+	FVector LaunchVelocity;
+	float EnergyCost = 0.f;
+	if (!AMechBoostJumpLink::ComputeBoostJump(Tuning, GetWorld()->GetGravityZ(), Mech->GetActorLocation(), Destination, LaunchVelocity, EnergyCost))
+	{
+		// This frame can't make the jump at all, not even from a full tank
+		AbandonBoostJump(Link);
+		return;
+	}
+
+	const float Energy = Mech->GetBoostEnergy();
+	if (Energy < EnergyCost)
+	{
+		if (Tuning.BoostRegenRate <= 0.f)
+		{
+			AbandonBoostJump(Link);
+			return;
+		}
+
+		// The cost fits in a full tank, so holding at the edge until the generator refills always ends
+		const float WaitTime = (EnergyCost - Energy) / Tuning.BoostRegenRate;
+		Mech->SetBoostRequested(false);
+		TWeakObjectPtr<AMechBoostJumpLink> WeakLink = Link;
+		GetWorldTimerManager().SetTimer(BoostJumpRetryTimer, FTimerDelegate::CreateWeakLambda(this, [this, WeakLink, Destination]()
+		{
+			BeginBoostJump(WeakLink.Get(), Destination);
+		}), FMath::Max(WaitTime, 0.1f), false);
+		return;
+	}
+
+	// Path following is paused on the link, so there is no input to fight braking or the walking
+	// speed cap; drop both and boost through the flight, which drains EnergyCost by the landing
+	Mech->GetMechMovement()->SetBoostJumping(true);
+	Mech->SetBoostRequested(EnergyCost > 0.f);
+	Mech->LaunchCharacter(LaunchVelocity, true, true);
+}
+
+void AMechAIController::AbandonBoostJump(AMechBoostJumpLink* Link)
+{
+	APlayerMech* Mech = GetMech();
+	ActiveBoostJumpLink.Reset();
+	Link->GetSmartLinkComp()->ResumePathFollowing(Mech);
+	StopMovement();
+
+	if (Mech)
+	{
+		Mech->SetBoostRequested(false);
+	}
+
+	if (bHasMoveGoal)
+	{
+		NumPathRetries = 0;
+		RequestBatchedPath(MoveGoal, NoBoostJumpFilterClass);
+	}
+}
+
+void AMechAIController::HandleLanded(const FHitResult& Hit)
+{
+	if (AMechBoostJumpLink* Link = ActiveBoostJumpLink.Get())
+	{
+		ActiveBoostJumpLink.Reset();
+
+		// UpdateBoost picks boosting back up if the next leg is long
+		if (APlayerMech* Mech = GetMech())
+		{
+			Mech->SetBoostRequested(false);
+		}
+		Link->GetSmartLinkComp()->ResumePathFollowing(GetPawn());
+	}
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/MechBoostJumpLink.h"
+#include "AI/MechAIController.h"
+#include "AI/NavArea_MechBoostJump.h"
+#include "Characters/PlayerMech.h"
+#include "Data/MechTuningData.h"
+#include "NavLinkCustomComponent.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+
+AMechBoostJumpLink::AMechBoostJumpLink()
+{
+	// Only the smart link is used; the default simple link would let pathing ignore the energy cost
+	PointLinks.Empty();
+	bSmartLinkIsRelevant = true;
+	GetSmartLinkComp()->SetEnabledArea(UNavArea_MechBoostJumpFree::StaticClass());
+}
+
+void AMechBoostJumpLink::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// Area costs are baked with the navmesh, so the tier is picked whenever the link is placed or edited
+	EnergyCost = ComputeLinkEnergyCost();
+	GetSmartLinkComp()->SetEnabledArea(UNavArea_MechBoostJump::GetAreaForEnergyCost(EnergyCost));
+}
+
+float AMechBoostJumpLink::ComputeLinkEnergyCost() const
+{
+	const UMechTuningData& Tuning = ReferenceTuning ? *ReferenceTuning : *GetDefault<UMechTuningData>();
+	const float GravityZ = GetWorld() ? GetWorld()->GetGravityZ() : UPhysicsSettings::Get()->DefaultGravityZ;
+
+	const UNavLinkCustomComponent* SmartLink = GetSmartLinkComp();
+	const FVector Start = GetActorTransform().TransformPosition(SmartLink->GetStartPoint());
+	const FVector End = GetActorTransform().TransformPosition(SmartLink->GetEndPoint());
+
+	// A jump no reference mech can make gets the top tier; bots that can't make it route around at runtime
+	auto DirectionCost = [&Tuning, GravityZ](const FVector& From, const FVector& To)
+	{
+		FVector LaunchVelocity;
+		float Cost = 0.f;
+		return ComputeBoostJump(Tuning, GravityZ, From, To, LaunchVelocity, Cost) ? Cost : BIG_NUMBER;
+	};
+
+	float Cost = DirectionCost(Start, End);
+	if (SmartLink->GetLinkDirection() == ENavLinkDirection::BothWays)
+	{
+		Cost = FMath::Max(Cost, DirectionCost(End, Start));
+	}
+	return Cost;
+}
+
+void AMechBoostJumpLink::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnSmartLinkReached.AddDynamic(this, &AMechBoostJumpLink::HandleSmartLinkReached);
+}
+
+bool AMechBoostJumpLink::ComputeBoostJump(const UMechTuningData& Tuning, float GravityZ, const FVector& From, const FVector& To, FVector& OutLaunchVelocity, float& OutEnergyCost)
+{
+	const float Gravity = -GravityZ * Tuning.GravityScale;
+	const float JumpVelocity = Tuning.MechJumpVelocity;
+	const float Height = To.Z - From.Z;
+	const float Discriminant = FMath::Square(JumpVelocity) - 2.f * Gravity * Height;
+	if (Gravity <= 0.f || Discriminant < 0.f)
+	{
+		return false;
+	}
+
+	// Land on the way down so the mech clears the edge before touching the far side
+	const float FlightTime = (JumpVelocity + FMath::Sqrt(Discriminant)) / Gravity;
+	const FVector Horizontal(To.X - From.X, To.Y - From.Y, 0.f);
+	const float HorizontalSpeed = Horizontal.Size() / FlightTime;
+	if (HorizontalSpeed > Tuning.BoostSpeed)
+	{
+		return false;
+	}
+
+	// Anything a normal jump can't cover needs boosting for the whole flight
+	OutEnergyCost = HorizontalSpeed > Tuning.NormalSpeed ? Tuning.BoostDepleteRate * FlightTime : 0.f;
+	if (OutEnergyCost > Tuning.MaxBoostEnergy)
+	{
+		return false;
+	}
+
+	OutLaunchVelocity = Horizontal.GetSafeNormal() * HorizontalSpeed;
+	OutLaunchVelocity.Z = JumpVelocity;
+	return true;
+}
+
+void AMechBoostJumpLink::HandleSmartLinkReached(AActor* MovingActor, const FVector& DestinationPoint)
+{
+	APlayerMech* Mech = Cast<APlayerMech>(MovingActor);
+	AMechAIController* MechController = Mech ? Cast<AMechAIController>(Mech->GetController()) : nullptr;
+	if (MechController)
+	{
+		MechController->BeginBoostJump(this, DestinationPoint);
+	}
+	else
+	{
+		GetSmartLinkComp()->ResumePathFollowing(MovingActor);
+	}
+}
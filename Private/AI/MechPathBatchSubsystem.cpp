@@ -0,0 +1,367 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/MechPathBatchSubsystem.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "../../ProjectMC.h"
+
+DECLARE_CYCLE_STAT(TEXT("Mech Path Batch Tick"), STAT_MechPathBatchTick, STATGROUP_ProjectMC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mech Path Queries Dispatched"), STAT_MechPathQueries, STATGROUP_ProjectMC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mech Path Cache Hits"), STAT_MechPathCacheHits, STATGROUP_ProjectMC);
+
+static TAutoConsoleVariable<int32> CVarMechPathQueriesPerFrame(
+	TEXT("mc.AI.PathQueriesPerFrame"),
+	8,
+	TEXT("Maximum number of async path queries mech AI dispatches per frame."));
+
+static TAutoConsoleVariable<float> CVarMechPathStartCellSize(
+	TEXT("mc.AI.PathStartCellSize"),
+	400.f,
+	TEXT("Requests whose start points fall in the same cell of this size can share a path."));
+
+static TAutoConsoleVariable<float> CVarMechPathGoalCellSize(
+	TEXT("mc.AI.PathGoalCellSize"),
+	300.f,
+	TEXT("Requests whose goals fall in the same cell of this size can share a path."));
+
+static TAutoConsoleVariable<float> CVarMechPathCacheLifetime(
+	TEXT("mc.AI.PathCacheLifetime"),
+	4.f,
+	TEXT("Seconds a finished path stays available for reuse."));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdMechPathStats(
+	TEXT("mc.AI.PathStats"),
+	TEXT("Logs mech AI path query throughput and game-thread cost. Pass 'reset' to restart the window."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UMechPathBatchSubsystem* PathBatch = World ? World->GetSubsystem<UMechPathBatchSubsystem>() : nullptr)
+		{
+			PathBatch->LogStats(Args.Num() > 0 && Args[0] == TEXT("reset"));
+		}
+	}));
+
+void UMechPathBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	StatsStartTime = FPlatformTime::Seconds();
+
+	// Cached paths are only valid for the navmesh they were built on
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &UMechPathBatchSubsystem::HandleNavigationGenerated);
+	}
+}
+
+void UMechPathBatchSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UMechPathBatchSubsystem::HandleNavigationGenerated);
+
+		for (const TPair<FMechPathKey, FPendingPath>& Pair : PendingPaths)
+		{
+			if (Pair.Value.QueryId != INVALID_NAVQUERYID)
+			{
+				NavSys->AbortAsyncFindPathRequest(Pair.Value.QueryId);
+			}
+		}
+	}
+
+	PendingPaths.Empty();
+	DispatchQueue.Empty();
+	PathCache.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UMechPathBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMechPathBatchSubsystem, STATGROUP_Tickables);
+}
+
+FMechPathKey UMechPathBatchSubsystem::MakeKey(const FVector& Start, const FVector& Goal, TSubclassOf<UNavigationQueryFilter> FilterClass) const
+{
+	const float StartCellSize = FMath::Max(CVarMechPathStartCellSize.GetValueOnGameThread(), 1.f);
+	const float GoalCellSize = FMath::Max(CVarMechPathGoalCellSize.GetValueOnGameThread(), 1.f);
+
+	FMechPathKey Key;
+	Key.StartCell = FIntVector(FMath::FloorToInt32(Start.X / StartCellSize), FMath::FloorToInt32(Start.Y / StartCellSize), FMath::FloorToInt32(Start.Z / StartCellSize));
+	Key.GoalCell = FIntVector(FMath::FloorToInt32(Goal.X / GoalCellSize), FMath::FloorToInt32(Goal.Y / GoalCellSize), FMath::FloorToInt32(Goal.Z / GoalCellSize));
+	Key.FilterClass = FilterClass.Get();
+	return Key;
+}
+
+void UMechPathBatchSubsystem::RequestPath(const APawn* Requester, const FVector& Start, const FVector& Goal, TSubclassOf<UNavigationQueryFilter> FilterClass, FOnMechPathReady OnReady)
+{
+	++NumRequests;
+
+	const FMechPathKey Key = MakeKey(Start, Goal, FilterClass);
+
+	FPathWaiter Waiter;
+	Waiter.Requester = Requester;
+	Waiter.Start = Start;
+	Waiter.Goal = Goal;
+	Waiter.OnReady = MoveTemp(OnReady);
+
+	const FNavAgentProperties& AgentProperties = Requester ? Requester->GetNavAgentPropertiesRef() : FNavAgentProperties::DefaultProperties;
+
+	if (const FCachedPath* CachedPath = PathCache.Find(Key))
+	{
+		if (CachedPath->NavData.IsValid() && GetWorld()->GetTimeSeconds() - CachedPath->Timestamp <= CVarMechPathCacheLifetime.GetValueOnGameThread())
+		{
+			++NumCacheHits;
+			INC_DWORD_STAT(STAT_MechPathCacheHits);
+
+			// The delivery may queue a query of its own, so don't hand it a reference into the cache
+			const FCachedPath CachedPathCopy = *CachedPath;
+			DeliverSharedPath(CachedPathCopy, MoveTemp(Waiter), AgentProperties);
+			return;
+		}
+
+		PathCache.Remove(Key);
+	}
+
+	if (FPendingPath* PendingPath = PendingPaths.Find(Key))
+	{
+		++NumCoalesced;
+		PendingPath->Waiters.Add(MoveTemp(Waiter));
+		return;
+	}
+
+	AddPendingPath(Key, FilterClass, AgentProperties, MoveTemp(Waiter));
+}
+
+void UMechPathBatchSubsystem::AddPendingPath(const FMechPathKey& Key, TSubclassOf<UNavigationQueryFilter> FilterClass, const FNavAgentProperties& AgentProperties, FPathWaiter&& Waiter)
+{
+	FPendingPath& PendingPath = PendingPaths.Add(Key);
+	PendingPath.Start = Waiter.Start;
+	PendingPath.Goal = Waiter.Goal;
+	PendingPath.FilterClass = FilterClass;
+	PendingPath.AgentProperties = AgentProperties;
+	PendingPath.Waiters.Add(MoveTemp(Waiter));
+	DispatchQueue.Add(Key);
+}
+
+void UMechPathBatchSubsystem::CancelRequests(const APawn* Requester)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	for (auto It = PendingPaths.CreateIterator(); It; ++It)
+	{
+		FPendingPath& PendingPath = It.Value();
+		PendingPath.Waiters.RemoveAllSwap([Requester](const FPathWaiter& Waiter)
+		{
+			return !Waiter.Requester.IsValid() || Waiter.Requester.Get() == Requester;
+		});
+
+		if (PendingPath.Waiters.Num() == 0)
+		{
+			if (NavSys && PendingPath.QueryId != INVALID_NAVQUERYID)
+			{
+				NavSys->AbortAsyncFindPathRequest(PendingPath.QueryId);
+			}
+
+			DispatchQueue.RemoveSingle(It.Key());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UMechPathBatchSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MechPathBatchTick);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Take the batch off the queue first; failure callbacks may queue or cancel requests
+	const int32 Budget = FMath::Clamp(CVarMechPathQueriesPerFrame.GetValueOnGameThread(), 0, DispatchQueue.Num());
+	TArray<FMechPathKey, TInlineAllocator<16>> Batch(DispatchQueue.GetData(), Budget);
+	DispatchQueue.RemoveAt(0, Budget, false);
+
+	for (const FMechPathKey& Key : Batch)
+	{
+		if (FPendingPath* PendingPath = PendingPaths.Find(Key))
+		{
+			DispatchQuery(Key, *PendingPath);
+		}
+	}
+
+	// Expire stale paths so the cache stays bounded by recent demand
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float Lifetime = CVarMechPathCacheLifetime.GetValueOnGameThread();
+	for (auto It = PathCache.CreateIterator(); It; ++It)
+	{
+		if (Now - It.Value().Timestamp > Lifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	GameThreadSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UMechPathBatchSubsystem::DispatchQuery(const FMechPathKey& Key, FPendingPath& PendingPath)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(PendingPath.AgentProperties, PendingPath.Start) : nullptr;
+	if (!NavData)
+	{
+		HandlePathFound(INVALID_NAVQUERYID, ENavigationQueryResult::Error, nullptr, Key);
+		return;
+	}
+
+	FPathFindingQuery Query(this, *NavData, PendingPath.Start, PendingPath.Goal, UNavigationQueryFilter::GetQueryFilter(*NavData, this, PendingPath.FilterClass));
+	PendingPath.QueryId = NavSys->FindPathAsync(PendingPath.AgentProperties, Query,
+		FNavPathQueryDelegate::CreateUObject(this, &UMechPathBatchSubsystem::HandlePathFound, Key));
+
+	++NumQueries;
+	INC_DWORD_STAT(STAT_MechPathQueries);
+}
+
+void UMechPathBatchSubsystem::HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, FMechPathKey Key)
+{
+	// Results of aborted queries can still arrive after the key was requested again
+	const FPendingPath* CurrentPath = PendingPaths.Find(Key);
+	if (!CurrentPath || CurrentPath->QueryId != QueryId)
+	{
+		return;
+	}
+
+	FPendingPath PendingPath;
+	PendingPaths.RemoveAndCopyValue(Key, PendingPath);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid())
+	{
+		for (const FPathWaiter& Waiter : PendingPath.Waiters)
+		{
+			Waiter.OnReady.ExecuteIfBound(nullptr);
+		}
+	}
+	else
+	{
+		// Callbacks may request new paths, so hand out copies of a local rather than the map entry
+		FCachedPath CachedPath;
+		CachedPath.PathPoints = Path->GetPathPoints();
+		CachedPath.NavData = Path->GetNavigationDataUsed();
+		CachedPath.FilterClass = PendingPath.FilterClass;
+		CachedPath.bIsPartial = Path->IsPartial();
+		CachedPath.Timestamp = GetWorld()->GetTimeSeconds();
+
+		if (Key.Exclusive != 0)
+		{
+			// Queried from this waiter's own start and goal, so it needs no adapting and isn't shared
+			for (const FPathWaiter& Waiter : PendingPath.Waiters)
+			{
+				if (Waiter.Requester.IsValid())
+				{
+					Waiter.OnReady.ExecuteIfBound(CopyPath(CachedPath, Waiter));
+				}
+			}
+		}
+		else
+		{
+			PathCache.Add(Key, CachedPath);
+
+			for (FPathWaiter& Waiter : PendingPath.Waiters)
+			{
+				if (Waiter.Requester.IsValid())
+				{
+					DeliverSharedPath(CachedPath, MoveTemp(Waiter), PendingPath.AgentProperties);
+				}
+			}
+		}
+	}
+
+	GameThreadSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UMechPathBatchSubsystem::DeliverSharedPath(const FCachedPath& CachedPath, FPathWaiter&& Waiter, const FNavAgentProperties& AgentProperties)
+{
+	if (FNavPathSharedPtr Path = MakeWaiterPath(CachedPath, Waiter))
+	{
+		Waiter.OnReady.ExecuteIfBound(Path);
+		return;
+	}
+
+	// Bending the shared path to this waiter would cut through something; query its own
+	++NumRequeried;
+	FMechPathKey Key = MakeKey(Waiter.Start, Waiter.Goal, CachedPath.FilterClass);
+	Key.Exclusive = ++LastExclusiveKey;
+	AddPendingPath(Key, CachedPath.FilterClass, AgentProperties, MoveTemp(Waiter));
+}
+
+FNavPathSharedPtr UMechPathBatchSubsystem::MakeWaiterPath(const FCachedPath& CachedPath, const FPathWaiter& Waiter) const
+{
+	const ANavigationData* NavData = CachedPath.NavData.Get();
+	const TArray<FNavPathPoint>& Points = CachedPath.PathPoints;
+	if (!NavData || Points.Num() < 2)
+	{
+		return nullptr;
+	}
+
+	// A partial path stops short of every goal in its cell, so only its start moves
+	const int32 LastIndex = Points.Num() - 1;
+	const bool bMoveGoal = !CachedPath.bIsPartial;
+
+	// The new first and last legs replace ones the query checked, so check them the same way
+	FSharedConstNavQueryFilter QueryFilter = UNavigationQueryFilter::GetQueryFilter(*NavData, Waiter.Requester.Get(), CachedPath.FilterClass);
+	const FVector FirstLegEnd = bMoveGoal && LastIndex == 1 ? Waiter.Goal : Points[1].Location;
+	FVector HitLocation;
+	if (NavData->Raycast(Waiter.Start, FirstLegEnd, HitLocation, QueryFilter, Waiter.Requester.Get()))
+	{
+		return nullptr;
+	}
+	if (bMoveGoal && LastIndex > 1 && NavData->Raycast(Points[LastIndex - 1].Location, Waiter.Goal, HitLocation, QueryFilter, Waiter.Requester.Get()))
+	{
+		return nullptr;
+	}
+
+	FNavPathSharedPtr Path = CopyPath(CachedPath, Waiter);
+	Path->GetPathPoints()[0].Location = Waiter.Start;
+	if (bMoveGoal)
+	{
+		Path->GetPathPoints()[LastIndex].Location = Waiter.Goal;
+	}
+	return Path;
+}
+
+FNavPathSharedPtr UMechPathBatchSubsystem::CopyPath(const FCachedPath& CachedPath, const FPathWaiter& Waiter)
+{
+	// Path following mutates and observes its path, so every follower gets its own copy
+	FNavPathSharedPtr Path = MakeShared<FNavigationPath, ESPMode::ThreadSafe>();
+	Path->GetPathPoints() = CachedPath.PathPoints;
+	Path->SetNavigationDataUsed(CachedPath.NavData.Get());
+	Path->SetQuerier(Waiter.Requester.Get());
+	Path->SetIsPartial(CachedPath.bIsPartial);
+	Path->MarkReady();
+	return Path;
+}
+
+void UMechPathBatchSubsystem::HandleNavigationGenerated(ANavigationData* NavData)
+{
+	PathCache.Empty();
+}
+
+void UMechPathBatchSubsystem::LogStats(bool bReset)
+{
+	const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StatsStartTime, UE_SMALL_NUMBER);
+
+	UE_LOG(LogProjectMC, Log, TEXT("Mech paths over %.1fs: %lld requests, %lld queries (%.1f/s), %lld cache hits, %lld coalesced, %lld re-queried, %d pending, %d cached, game thread %.3f ms/s"),
+		Elapsed, NumRequests, NumQueries, NumQueries / Elapsed, NumCacheHits, NumCoalesced, NumRequeried, PendingPaths.Num(), PathCache.Num(), GameThreadSeconds * 1000.0 / Elapsed);
+
+	if (bReset)
+	{
+		NumRequests = 0;
+		NumQueries = 0;
+		NumCacheHits = 0;
+		NumCoalesced = 0;
+		NumRequeried = 0;
+		GameThreadSeconds = 0.0;
+		StatsStartTime = FPlatformTime::Seconds();
+	}
+}
@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/MechAIController.h"
+#include "AI/MechPathBatchSubsystem.h"
+#include "Characters/PlayerMech.h"
+#include "Debug/MechTimedRun.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+#include "../../ProjectMC.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Spawns squads of bot mechs that keep moving between random goals shared within each squad,
+ * then logs path query throughput and game-thread cost. Exits afterwards with -MechPathBenchExit.
+ */
+class FMechPathBenchmark : public FMechTimedRun
+{
+public:
+	static constexpr int32 SquadSize = 8;
+
+	/** Bots that haven't reached their goal after this long get a new one */
+	static constexpr float GoalTimeout = 20.f;
+
+	FMechPathBenchmark(UWorld& InWorld, int32 NumBots, float InSeconds, float InRadius)
+		: FMechTimedRun(TEXT("MechPathBenchExit"), InSeconds)
+		, World(&InWorld)
+		, Radius(InRadius)
+	{
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld);
+		APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(&InWorld, 0);
+		Origin = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+
+		// Use the game's mech class when it has one so bots carry the real mesh, collision and tuning
+		const AGameModeBase* GameMode = InWorld.GetAuthGameMode();
+		UClass* MechClass = GameMode && GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf<APlayerMech>()
+			? GameMode->DefaultPawnClass.Get() : APlayerMech::StaticClass();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		for (int32 BotIndex = 0; BotIndex < NumBots && NavSys; ++BotIndex)
+		{
+			FNavLocation SpawnLocation;
+			if (!NavSys->GetRandomReachablePointInRadius(Origin, Radius, SpawnLocation))
+			{
+				continue;
+			}
+
+			APlayerMech* Bot = InWorld.SpawnActor<APlayerMech>(MechClass, SpawnLocation.Location + FVector(0.f, 0.f, 200.f), FRotator::ZeroRotator, SpawnParams);
+			if (Bot)
+			{
+				Bot->SpawnDefaultController();
+				Bots.Add(Bot);
+			}
+		}
+
+		SquadGoals.SetNumZeroed(FMath::DivideAndRoundUp(Bots.Num(), SquadSize));
+		GoalTimes.SetNumZeroed(Bots.Num());
+		SentGoals.SetNumZeroed(Bots.Num());
+
+		if (UMechPathBatchSubsystem* PathBatch = InWorld.GetSubsystem<UMechPathBatchSubsystem>())
+		{
+			PathBatch->LogStats(true);
+		}
+
+		UE_LOG(LogProjectMC, Log, TEXT("mc.AI.PathBench: spawned %d/%d bots in %d squads"), Bots.Num(), NumBots, SquadGoals.Num());
+	}
+
+private:
+	virtual bool TickRun(float DeltaTime) override
+	{
+		UWorld* BenchWorld = World.Get();
+		if (!BenchWorld)
+		{
+			return false;
+		}
+
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(BenchWorld);
+		const double Now = BenchWorld->GetTimeSeconds();
+
+		for (int32 BotIndex = 0; BotIndex < Bots.Num(); ++BotIndex)
+		{
+			APlayerMech* Bot = Bots[BotIndex].Get();
+			AMechAIController* Controller = Bot ? Cast<AMechAIController>(Bot->GetController()) : nullptr;
+			if (!Controller || (Controller->HasMoveGoal() && Now - GoalTimes[BotIndex] < GoalTimeout))
+			{
+				continue;
+			}
+
+			// A bot that is done with the squad's current goal picks the next one; the rest of the squad
+			// follows it as each finishes and gets the path from the cache or the query in flight.
+			// Resending a goal the bot already reached would only inflate the numbers.
+			FSquadGoal& SquadGoal = SquadGoals[BotIndex / SquadSize];
+			if (SquadGoal.Generation == 0 || SentGoals[BotIndex] == SquadGoal.Generation)
+			{
+				FNavLocation GoalLocation;
+				if (!NavSys || !NavSys->GetRandomReachablePointInRadius(Origin, Radius, GoalLocation))
+				{
+					continue;
+				}
+				SquadGoal.Location = GoalLocation.Location;
+				++SquadGoal.Generation;
+			}
+
+			Controller->MoveToLocationBatched(SquadGoal.Location);
+			GoalTimes[BotIndex] = Now;
+			SentGoals[BotIndex] = SquadGoal.Generation;
+		}
+
+		return true;
+	}
+
+	virtual void FinishRun() override
+	{
+		if (UWorld* BenchWorld = World.Get())
+		{
+			UE_LOG(LogProjectMC, Log, TEXT("mc.AI.PathBench: %d bots for %.1fs"), Bots.Num(), GetElapsed());
+			LogFrameStats();
+
+			if (UMechPathBatchSubsystem* PathBatch = BenchWorld->GetSubsystem<UMechPathBatchSubsystem>())
+			{
+				PathBatch->LogStats(false);
+			}
+		}
+
+		for (const TWeakObjectPtr<APlayerMech>& Bot : Bots)
+		{
+			if (APlayerMech* BotMech = Bot.Get())
+			{
+				if (AController* Controller = BotMech->GetController())
+				{
+					Controller->Destroy();
+				}
+				BotMech->Destroy();
+			}
+		}
+		Bots.Empty();
+	}
+
+	struct FSquadGoal
+	{
+		FVector Location = FVector::ZeroVector;
+
+		/** Bumped on every new goal; zero until the squad has one */
+		int32 Generation = 0;
+	};
+
+	TWeakObjectPtr<UWorld> World;
+	FVector Origin = FVector::ZeroVector;
+	float Radius;
+	TArray<TWeakObjectPtr<APlayerMech>> Bots;
+	TArray<FSquadGoal> SquadGoals;
+	TArray<double> GoalTimes;
+
+	/** Generation of the squad goal each bot was last sent */
+	TArray<int32> SentGoals;
+};
+
+static FAutoConsoleCommandWithWorldAndArgs CmdMechPathBench(
+	TEXT("mc.AI.PathBench"),
+	TEXT("Spawns squads of bot mechs roaming between shared random goals and logs path query throughput and game-thread cost. Usage: mc.AI.PathBench [NumBots=64] [Seconds=60] [Radius=20000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("mc.AI.PathBench needs a world with authority"));
+			return;
+		}
+
+		if (!FMechTimedRun::CanStart(TEXT("mc.AI.PathBench")))
+		{
+			return;
+		}
+
+		const int32 NumBots = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 64;
+		const float Seconds = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 60.f;
+		const float Radius = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 20000.f;
+		FMechTimedRun::Start(MakeUnique<FMechPathBenchmark>(*World, NumBots, Seconds, Radius));
+	}));
+
+#endif
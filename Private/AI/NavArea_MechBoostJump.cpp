@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/NavArea_MechBoostJump.h"
+
+TSubclassOf<UNavArea_MechBoostJump> UNavArea_MechBoostJump::GetAreaForEnergyCost(float EnergyCost)
+{
+	if (EnergyCost <= 0.f)
+	{
+		return UNavArea_MechBoostJumpFree::StaticClass();
+	}
+
+	TConstArrayView<TSubclassOf<UNavArea_MechBoostJump>> Tiers = GetBoostedTiers();
+	for (const TSubclassOf<UNavArea_MechBoostJump>& Tier : Tiers)
+	{
+		if (EnergyCost <= Tier->GetDefaultObject<UNavArea_MechBoostJump>()->GetEnergyCost())
+		{
+			return Tier;
+		}
+	}
+	return Tiers.Last();
+}
+
+TConstArrayView<TSubclassOf<UNavArea_MechBoostJump>> UNavArea_MechBoostJump::GetBoostedTiers()
+{
+	static const TSubclassOf<UNavArea_MechBoostJump> Tiers[] =
+	{
+		UNavArea_MechBoostJump25::StaticClass(),
+		UNavArea_MechBoostJump50::StaticClass(),
+		UNavArea_MechBoostJump100::StaticClass(),
+		UNavArea_MechBoostJump200::StaticClass(),
+	};
+	return Tiers;
+}
+
+void UNavArea_MechBoostJump::SetEnergyCost(float InEnergyCost)
+{
+	EnergyCost = InEnergyCost;
+	DefaultCost = 1.f;
+	FixedAreaEnteringCost = EnergyCost * CostPerEnergy;
+	DrawColor = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, FMath::Min(EnergyCost / 200.f, 1.f)).ToFColor(true);
+}
+
+UNavArea_MechBoostJumpFree::UNavArea_MechBoostJumpFree()
+{
+	SetEnergyCost(0.f);
+}
+
+UNavArea_MechBoostJump25::UNavArea_MechBoostJump25()
+{
+	SetEnergyCost(25.f);
+}
+
+UNavArea_MechBoostJump50::UNavArea_MechBoostJump50()
+{
+	SetEnergyCost(50.f);
+}
+
+UNavArea_MechBoostJump100::UNavArea_MechBoostJump100()
+{
+	SetEnergyCost(100.f);
+}
+
+UNavArea_MechBoostJump200::UNavArea_MechBoostJump200()
+{
+	SetEnergyCost(200.f);
+}
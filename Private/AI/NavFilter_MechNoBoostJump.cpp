@@ -0,0 +1,16 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/NavFilter_MechNoBoostJump.h"
+#include "AI/NavArea_MechBoostJump.h"
+
+UNavFilter_MechNoBoostJump::UNavFilter_MechNoBoostJump()
+{
+	// Plain jumps stay usable; only tiers that spend energy are excluded
+	for (const TSubclassOf<UNavArea_MechBoostJump>& Tier : UNavArea_MechBoostJump::GetBoostedTiers())
+	{
+		FNavigationFilterArea& BoostJumpArea = Areas.AddDefaulted_GetRef();
+		BoostJumpArea.AreaClass = Tier;
+		BoostJumpArea.bIsExcluded = true;
+	}
+}
@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/PlayerMech.h"
+#include "Components/MechMovementComponent.h"
+#include "Debug/MechTimedRun.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "WorldPartition/WorldPartitionRuntimeCell.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+#include "../../ProjectMC.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Flies a player mech in a straight line at a fixed speed and counts hitches and frames where the
+ * mech was inside cells that weren't activated yet. Exits afterwards with -MechFlythroughExit.
+ * Run it with mc.Mech.PredictiveStreaming on and off to compare.
+ */
+class FMechStreamingFlythrough : public FMechTimedRun
+{
+public:
+	/** Radius around the mech that must be activated for a frame not to count as late */
+	static constexpr float ProbeRadius = 3200.f;
+
+	FMechStreamingFlythrough(APlayerMech& InMech, float InSpeed, float InSeconds)
+		: FMechTimedRun(TEXT("MechFlythroughExit"), InSeconds)
+		, Mech(&InMech)
+		, Direction(InMech.GetActorForwardVector().GetSafeNormal2D())
+		, Speed(InSpeed)
+	{
+		InMech.GetMechMovement()->SetMovementMode(MOVE_None);
+	}
+
+private:
+	virtual bool TickRun(float DeltaTime) override
+	{
+		APlayerMech* FlyingMech = Mech.Get();
+		if (!FlyingMech)
+		{
+			return false;
+		}
+
+		// Velocity is what the predictive streaming source reads; the position is moved directly
+		UMechMovementComponent* MechMovement = FlyingMech->GetMechMovement();
+		MechMovement->Velocity = Direction * Speed;
+		FlyingMech->SetActorLocation(FlyingMech->GetActorLocation() + MechMovement->Velocity * DeltaTime);
+
+		if (const UWorldPartitionSubsystem* WorldPartitionSubsystem = FlyingMech->GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+		{
+			FWorldPartitionStreamingQuerySource QuerySource(FlyingMech->GetActorLocation());
+			QuerySource.bUseGridLoadingRange = false;
+			QuerySource.Radius = ProbeRadius;
+
+			const bool bLate = !WorldPartitionSubsystem->IsStreamingCompleted(EWorldPartitionRuntimeCellState::Activated, { QuerySource }, false);
+			if (bLate)
+			{
+				++NumLateFrames;
+				if (!bWasLate)
+				{
+					++NumLateEpisodes;
+				}
+			}
+			bWasLate = bLate;
+		}
+
+		return true;
+	}
+
+	virtual void FinishRun() override
+	{
+		if (APlayerMech* FlyingMech = Mech.Get())
+		{
+			FlyingMech->GetMechMovement()->SetMovementMode(MOVE_Falling);
+		}
+
+		UE_LOG(LogProjectMC, Log, TEXT("mc.Mech.StreamingFlythrough: %.0f u/s for %.1fs, predictive streaming %s"),
+			Speed, GetElapsed(), IConsoleManager::Get().FindConsoleVariable(TEXT("mc.Mech.PredictiveStreaming"))->GetBool() ? TEXT("on") : TEXT("off"));
+		LogFrameStats();
+		UE_LOG(LogProjectMC, Log, TEXT("  %d frames (%d episodes) inside cells that weren't activated yet"),
+			NumLateFrames, NumLateEpisodes);
+	}
+
+	TWeakObjectPtr<APlayerMech> Mech;
+	FVector Direction;
+	float Speed;
+	int32 NumLateFrames = 0;
+	int32 NumLateEpisodes = 0;
+	bool bWasLate = false;
+};
+
+static FAutoConsoleCommandWithWorldAndArgs CmdMechStreamingFlythrough(
+	TEXT("mc.Mech.StreamingFlythrough"),
+	TEXT("Flies the first player mech forward and logs hitches and late-loaded cells. Usage: mc.Mech.StreamingFlythrough [Speed=1800] [Seconds=60]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!FMechTimedRun::CanStart(TEXT("mc.Mech.StreamingFlythrough")))
+		{
+			return;
+		}
+
+		// Only player mechs add a predictive source, so the fly-through needs one
+		APlayerMech* Mech = Cast<APlayerMech>(UGameplayStatics::GetPlayerPawn(World, 0));
+		for (TActorIterator<APlayerMech> It(World); It && !Mech; ++It)
+		{
+			if (It->IsPlayerControlled())
+			{
+				Mech = *It;
+			}
+		}
+
+		if (!Mech)
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("mc.Mech.StreamingFlythrough: no player-controlled mech in the world"));
+			return;
+		}
+
+		const float Speed = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 1800.f;
+		const float Seconds = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 60.f;
+		FMechTimedRun::Start(MakeUnique<FMechStreamingFlythrough>(*Mech, Speed, Seconds));
+	}));
+
+#endif
@@ -8,79 +8,408 @@
 #include "InputActionValue.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Components/TimelineComponent.h"
+#include "Data/MechTuningData.h"
+#include "Components/MechMovementComponent.h"
+#include "AI/MechAIController.h"
+#include "Loadout/MechLoadoutSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/PlayerState.h"
+#include "Telemetry/MechTelemetry.h"
+#include "EngineUtils.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "../../ProjectMC.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mech Predicted Streaming Shapes"), STAT_MechStreamingShapes, STATGROUP_ProjectMC);
+
+static TAutoConsoleVariable<bool> CVarMechPredictiveStreaming(
+	TEXT("mc.Mech.PredictiveStreaming"),
+	true,
+	TEXT("When enabled, mechs add a World Partition streaming source stretched along their predicted path."));
+
+static TAutoConsoleVariable<bool> CVarMechLegacyDash(
+	TEXT("mc.Mech.LegacyDash"),
+	false,
+	TEXT("When enabled, dashes use the old LaunchCharacter-then-clamp path instead of the dash movement mode, to compare per-tick cost. Not predicted; for local profiling only."));
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorld CmdMechMemReport(
+	TEXT("mc.Mech.MemReport"),
+	TEXT("Logs the UObject memory held by each mech and its components"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		int32 NumMechs = 0;
+		uint64 TotalBytes = 0;
+		for (TActorIterator<APlayerMech> It(World); It; ++It)
+		{
+			FArchiveCountMem ActorMem(*It);
+			uint64 MechBytes = ActorMem.GetMax();
+
+			TInlineComponentArray<UActorComponent*> Components(*It);
+			for (UActorComponent* Component : Components)
+			{
+				FArchiveCountMem ComponentMem(Component);
+				MechBytes += ComponentMem.GetMax();
+			}
+
+			UE_LOG(LogProjectMC, Log, TEXT("%s: %llu bytes across %d components"), *It->GetName(), MechBytes, Components.Num());
+			TotalBytes += MechBytes;
+			++NumMechs;
+		}
 
-APlayerMech::APlayerMech()
+		UE_LOG(LogProjectMC, Log, TEXT("%d mechs, %llu bytes total, %llu bytes per mech"), NumMechs, TotalBytes, NumMechs > 0 ? TotalBytes / NumMechs : 0);
+	}));
+#endif
+
+namespace PlayerMechTracks
+{
+	static const FName TurnDash(TEXT("TurnDash"));
+}
+
+APlayerMech::APlayerMech(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UMechMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
-	// Set default mech movement properties
+	// Tuned values (jump, air control, speeds, friction) come from TuningData in ApplyTuning
 	if (UCharacterMovementComponent* MovementComp = GetCharacterMovement())
 	{
-		MovementComp->JumpZVelocity = MechJumpVelocity;
-		MovementComp->AirControl = MechAirControl;
-		MovementComp->GravityScale = 1.5f; 
-		MovementComp->BrakingFrictionFactor = 0.f;
-		MovementComp->GroundFriction = 0.f;
-		MovementComp->MaxWalkSpeed = NormalSpeed;
 		MovementComp->bAllowPhysicsRotationDuringAnimRootMotion = true;
 		MovementComp->bOrientRotationToMovement = true;
-		MovementComp->RotationRate = FRotator(0.0f, 500.0f, 0.0f); // 회전 속도 설정
 	}
 	
 	bUseControllerRotationPitch = false;
 	bUseControllerRotationYaw = false; 
 	bUseControllerRotationRoll = false;
 
-	DashCooldownTimeline = CreateDefaultSubobject<UTimelineComponent>(TEXT("DashCooldownTimeline"));
-	TurnDashTimeline = CreateDefaultSubobject<UTimelineComponent>(TEXT("TurnDashTimeline"));
-	VelocityDampingTimeline = CreateDefaultSubobject<UTimelineComponent>(TEXT("VelocityDampingTimeline"));
+	// Boost energy is evaluated on read and depletion is a timer, so the actor itself never ticks
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Bots spawned or placed without a player get the mech AI
+	AIControllerClass = AMechAIController::StaticClass();
+
+	// Turn dashes only rotate the local player's view; dedicated servers stop its tick at runtime
+	TurnDashTimeline = CreateOptionalDefaultSubobject<UTimelineComponent>(TEXT("TurnDashTimeline"));
+}
+
+const UMechTuningData& APlayerMech::GetTuning() const
+{
+	return *GetTuningAsset();
+}
+
+UMechTuningData* APlayerMech::GetTuningAsset() const
+{
+	return TuningData ? TuningData : GetMutableDefault<UMechTuningData>();
+}
+
+UMechMovementComponent* APlayerMech::GetMechMovement() const
+{
+	return CastChecked<UMechMovementComponent>(GetCharacterMovement());
+}
+
+void APlayerMech::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	if (UMechTuningData* LoadoutTuning = GetLoadoutTuning())
+	{
+		TuningData = LoadoutTuning;
+	}
+
+	ApplyTuning();
+
+	BoostEnergyState.MaxEnergy = GetTuning().MaxBoostEnergy;
+	BoostEnergyState.BaseEnergy = BoostEnergyState.MaxEnergy;
+	BoostEnergyState.BaseTime = GetEnergyTime();
+	BoostEnergyState.Rate = GetTuning().BoostRegenRate;
+}
+
+UMechTuningData* APlayerMech::GetLoadoutTuning() const
+{
+	UGameInstance* GameInstance = GetGameInstance();
+	if (!GameInstance || !Loadout.IsComplete())
+	{
+		return nullptr;
+	}
+
+	// Derive from the frame tuning even when the current tuning is itself derived from a loadout
+	UMechTuningData* CurrentTuning = GetTuningAsset();
+	UMechTuningData* BaseTuning = CurrentTuning->LoadoutBase ? CurrentTuning->LoadoutBase : CurrentTuning;
+
+	return GameInstance->GetSubsystem<UMechLoadoutSubsystem>()->GetTuningForLoadout(Loadout, BaseTuning);
+}
+
+void APlayerMech::SetTuningData(UMechTuningData* NewTuningData)
+{
+	if (NewTuningData == TuningData)
+	{
+		return;
+	}
+
+	GetTuningAsset()->OnTuningChanged.Remove(TuningChangedHandle);
+	TuningChangedHandle.Reset();
+
+	TuningData = NewTuningData;
+
+	if (HasActorBegunPlay())
+	{
+		TuningChangedHandle = GetTuningAsset()->OnTuningChanged.AddUObject(this, &APlayerMech::HandleTuningChanged);
+	}
+
+	HandleTuningChanged(TuningData);
+}
+
+void APlayerMech::EquipPart(UMechPartData* Part)
+{
+	if (!Part)
+	{
+		return;
+	}
+
+	Loadout.SetPart(Part);
+
+	if (UMechTuningData* LoadoutTuning = GetLoadoutTuning())
+	{
+		SetTuningData(LoadoutTuning);
+	}
+}
+
+double APlayerMech::GetEnergyTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+float APlayerMech::GetBoostEnergy() const
+{
+	return BoostEnergyState.Evaluate(GetEnergyTime());
+}
+
+void APlayerMech::UpdateBoostEnergyRate()
+{
+	const UMechTuningData& Tuning = GetTuning();
+	const double Now = GetEnergyTime();
+	BoostEnergyState.Rebase(Now, bIsBoosting ? -Tuning.BoostDepleteRate : Tuning.BoostRegenRate);
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	TimerManager.ClearTimer(BoostDepletedTimer);
+
+	if (bIsBoosting)
+	{
+		const float TimeToEmpty = BoostEnergyState.TimeUntil(Now, 0.f);
+		if (TimeToEmpty == 0.f)
+		{
+			HandleBoostDepleted();
+		}
+		else if (TimeToEmpty > 0.f)
+		{
+			TimerManager.SetTimer(BoostDepletedTimer, this, &APlayerMech::HandleBoostDepleted, TimeToEmpty, false);
+		}
+	}
+}
+
+void APlayerMech::HandleBoostDepleted()
+{
+	if (MechTelemetry::IsActive())
+	{
+		RecordTelemetry(EMechTelemetryEvent::BoostDepleted, EMechDashType::None, GetBoostEnergy(), GetVelocity().Size2D());
+	}
+
+	EndBoost();
+}
+
+void APlayerMech::RecordTelemetry(EMechTelemetryEvent Event, EMechDashType DashType, float EnergyBefore, float Speed) const
+{
+	// Every event is recorded once, by whoever controls the mech: the owning client for players and
+	// the server for bots. The server's copy of a remote player and client replays after a correction
+	// re-run the same input and would log it again.
+	if (!IsLocallyControlled() || GetCharacterMovement()->bClientUpdating)
+	{
+		return;
+	}
+
+	// GetUniqueID is recycled, so key players by their net id and other mechs by their name, which
+	// is stable for placed actors and for bots spawned in the same order
+	if (TelemetryMechId == 0)
+	{
+		const APlayerState* MechPlayerState = GetPlayerState();
+		const bool bHasNetId = MechPlayerState && MechPlayerState->GetUniqueId().IsValid();
+		TelemetryMechId = MechTelemetry::MakeMechId(bHasNetId ? MechPlayerState->GetUniqueId().ToString() : GetName());
+	}
+
+	FMechTelemetryRecord Record;
+	Record.Time = GetEnergyTime();
+	Record.MechId = TelemetryMechId;
+	Record.Event = Event;
+	Record.DashType = DashType;
+	Record.EnergyBefore = EnergyBefore;
+	Record.EnergyAfter = GetBoostEnergy();
+	Record.Speed = Speed;
+	MechTelemetry::Record(Record);
 }
 
 void APlayerMech::BeginPlay()
 {
 	Super::BeginPlay();
 
+	const UMechTuningData& Tuning = GetTuning();
 
-
-	if (TurnDashCurve)
+	if (TurnDashTimeline && Tuning.TurnDashCurve)
 	{
 		FOnTimelineFloat TurnDashFloat;
 		TurnDashFloat.BindUFunction(this, FName("UpdateTurnDash"));
-		TurnDashTimeline->AddInterpFloat(TurnDashCurve, TurnDashFloat);
+		TurnDashTimeline->AddInterpFloat(Tuning.TurnDashCurve, TurnDashFloat, NAME_None, PlayerMechTracks::TurnDash);
+	}
+
+	// Mechs without an asset follow the class defaults, which mc.Mech.Tune can edit too
+	TuningChangedHandle = GetTuningAsset()->OnTuningChanged.AddUObject(this, &APlayerMech::HandleTuningChanged);
+
+	if (UWorldPartitionSubsystem* WorldPartitionSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+	{
+		WorldPartitionSubsystem->RegisterStreamingSourceProvider(this);
+	}
+}
+
+void APlayerMech::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetTuningAsset()->OnTuningChanged.Remove(TuningChangedHandle);
+
+	if (UWorldPartitionSubsystem* WorldPartitionSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+	{
+		WorldPartitionSubsystem->UnregisterStreamingSourceProvider(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void APlayerMech::ApplyTuning()
+{
+	const UMechTuningData& Tuning = GetTuning();
+
+	// Boost and dash speeds are read by the movement modes themselves, so MaxWalkSpeed stays put
+	UMechMovementComponent* MechMovement = GetMechMovement();
+	MechMovement->SetTuning(&Tuning);
+	MechMovement->JumpZVelocity = Tuning.MechJumpVelocity;
+	MechMovement->AirControl = Tuning.MechAirControl;
+	MechMovement->GravityScale = Tuning.GravityScale;
+	MechMovement->MaxWalkSpeed = Tuning.NormalSpeed;
+	MechMovement->GroundFriction = Tuning.GroundFriction;
+	MechMovement->BrakingFrictionFactor = Tuning.BrakingFrictionFactor;
+	MechMovement->RotationRate = FRotator(0.0f, Tuning.YawRotationRate, 0.0f);
+}
+
+void APlayerMech::HandleTuningChanged(const UMechTuningData* ChangedTuning)
+{
+	ApplyTuning();
+
+	const UMechTuningData& Tuning = GetTuning();
+	BoostEnergyState.Rebase(GetEnergyTime(), BoostEnergyState.Rate);
+	BoostEnergyState.MaxEnergy = Tuning.MaxBoostEnergy;
+	BoostEnergyState.BaseEnergy = FMath::Min(BoostEnergyState.BaseEnergy, BoostEnergyState.MaxEnergy);
+	UpdateBoostEnergyRate();
+
+	// Tracks that were bound in BeginPlay pick up curve edits; adding a curve needs a respawn
+	if (TurnDashTimeline)
+	{
+		TurnDashTimeline->SetFloatCurve(Tuning.TurnDashCurve, PlayerMechTracks::TurnDash);
+	}
+}
+
+bool APlayerMech::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& StreamingSources) const
+{
+	// The player controller already streams around the mech; this source only covers where it is
+	// heading. AI controllers are no streaming source, so bots don't get a look-ahead either.
+	// Simulated proxies don't drive streaming for their owning client.
+	if (!CVarMechPredictiveStreaming.GetValueOnGameThread() || !IsPlayerControlled() || (!IsLocallyControlled() && !HasAuthority()))
+	{
+		return false;
 	}
 
-	if (VelocityDampingCurve)
+	const UMechTuningData& Tuning = GetTuning();
+	const FVector Velocity = GetVelocity();
+	const float Speed = Velocity.Size();
+
+	// Near standstill the direction of travel says nothing about where the mech goes next
+	if (Speed < Tuning.StreamingMinSpeed)
 	{
-		FOnTimelineFloat VelocityDampingFloat;
-		VelocityDampingFloat.BindUFunction(this, FName("UpdateVelocityDamping"));
-		VelocityDampingTimeline->AddInterpFloat(VelocityDampingCurve, VelocityDampingFloat);
+		return false;
+	}
 
-		FOnTimelineEvent VelocityDampingFinished;
-		VelocityDampingFinished.BindUFunction(this, FName("FinishedVelocityDamping"));
-		VelocityDampingTimeline->SetTimelineFinishedFunc(VelocityDampingFinished);
+	const float PredictedDistance = GetPredictedTravelDistance(Speed);
+	if (PredictedDistance < Tuning.StreamingShapeSpacing)
+	{
+		return false;
 	}
+
+	FWorldPartitionStreamingSource& StreamingSource = StreamingSources.AddDefaulted_GetRef();
+	StreamingSource.Name = GetFName();
+	StreamingSource.Location = GetActorLocation();
+	StreamingSource.Rotation = Velocity.Rotation();
+	StreamingSource.Velocity = Speed;
+	StreamingSource.TargetState = EStreamingSourceTargetState::Activated;
+	StreamingSource.bBlockOnSlowLoading = false;
+	StreamingSource.Priority = Speed >= Tuning.StreamingHighPrioritySpeed ? EStreamingSourcePriority::High : EStreamingSourcePriority::Normal;
+
+	// Shapes are in source space, so they line up along +X (the direction of travel)
+	const int32 NumShapes = FMath::Min(FMath::FloorToInt32(PredictedDistance / Tuning.StreamingShapeSpacing), Tuning.StreamingMaxShapes);
+	const float Spacing = PredictedDistance / NumShapes;
+	for (int32 ShapeIndex = 1; ShapeIndex <= NumShapes; ++ShapeIndex)
+	{
+		FStreamingSourceShape& Shape = StreamingSource.Shapes.AddDefaulted_GetRef();
+		Shape.bUseGridLoadingRange = true;
+		Shape.LoadingRangeScale = Tuning.StreamingShapeRangeScale;
+		Shape.Location = FVector(Spacing * ShapeIndex, 0.f, 0.f);
+	}
+
+	INC_DWORD_STAT_BY(STAT_MechStreamingShapes, NumShapes);
+	return true;
 }
 
-void APlayerMech::Tick(float DeltaTime)
+float APlayerMech::GetPredictedTravelDistance(float Speed) const
 {
-	Super::Tick(DeltaTime);
+	const UMechTuningData& Tuning = GetTuning();
+	float Distance = Speed * Tuning.StreamingLookaheadSeconds;
+
+	const float Energy = GetBoostEnergy();
 
-	if (bIsBoosting && BoostEnergy > 0.f)
+	// A boosting mech keeps accelerating towards BoostSpeed for as long as its energy lasts
+	if (bIsBoosting && Tuning.BoostDepleteRate > 0.f)
 	{
-		GetCharacterMovement()->MaxWalkSpeed = BoostSpeed;
-		BoostEnergy -= BoostDepleteRate * DeltaTime;
+		const float BoostSeconds = FMath::Min(Energy / Tuning.BoostDepleteRate, Tuning.StreamingLookaheadSeconds);
+		const float BoostDistance = Tuning.BoostSpeed * BoostSeconds + Speed * (Tuning.StreamingLookaheadSeconds - BoostSeconds);
+		Distance = FMath::Max(Distance, BoostDistance);
+	}
 
-		if (BoostEnergy <= 0.f)
-		{
-			BoostEnergy = 0.f;
-			bIsBoosting = false;
-		}
+	// Enough energy for a dash means another burst at the dash velocity limit
+	if (Energy > Tuning.MinDashEnergy)
+	{
+		Distance += Tuning.DashVelocityLimit * Tuning.DashCooldown;
 	}
-	else
+
+	return FMath::Min(Distance, Tuning.StreamingMaxLookaheadDistance);
+}
+
+void APlayerMech::TrimForDedicatedServer()
+{
+	Super::TrimForDedicatedServer();
+
+	// Turn dashes only run for a local view
+	if (TurnDashTimeline)
+	{
+		TurnDashTimeline->SetComponentTickEnabled(false);
+	}
+}
+
+#if WITH_EDITOR
+void APlayerMech::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Part slots edited in the details panel bypass SetPart
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(APlayerMech, Loadout))
 	{
-		GetCharacterMovement()->MaxWalkSpeed = NormalSpeed;
-		BoostEnergy += BoostRegenRate * DeltaTime;
-		BoostEnergy = FMath::Min(BoostEnergy, MaxBoostEnergy);
+		Loadout.RefreshStats();
 	}
 }
+#endif
 
 void APlayerMech::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
@@ -116,18 +445,21 @@ void APlayerMech::Jump()
 	// Call Blueprint implementable event first
 	OnJumpStart();
 
-	// Apply custom mech jump logic
-	if (UCharacterMovementComponent* MovementComp = GetCharacterMovement())
-	{
-		// Update jump velocity with current mech settings
-		MovementComp->JumpZVelocity = MechJumpVelocity;
-		MovementComp->AirControl = MechAirControl;
-	}
-
+	// Jump velocity and air control are applied once from TuningData, not per jump
 	// Call parent Jump function
 	Super::Jump();
 }
 
+void APlayerMech::OnJumped_Implementation()
+{
+	Super::OnJumped_Implementation();
+
+	if (MechTelemetry::IsActive())
+	{
+		RecordTelemetry(EMechTelemetryEvent::Jump, EMechDashType::None, GetBoostEnergy(), GetVelocity().Size2D());
+	}
+}
+
 void APlayerMech::StopJumping()
 {
 	// Call Blueprint implementable event first
@@ -139,8 +471,27 @@ void APlayerMech::StopJumping()
 
 void APlayerMech::StartBoost()
 {
-	if (BoostEnergy >= 0.f)
+	if (GetBoostEnergy() > 0.f)
+	{
 		bIsBoosting = true;
+		GetMechMovement()->SetWantsToBoost(true);
+		UpdateBoostEnergyRate();
+	}
+}
+
+void APlayerMech::SetBoostRequested(bool bBoost)
+{
+	if (bBoost == bIsBoosting)
+		return;
+
+	if (bBoost)
+	{
+		StartBoost();
+	}
+	else
+	{
+		EndBoost();
+	}
 }
 
 void APlayerMech::Move(const FInputActionValue& Value)
@@ -186,7 +537,7 @@ void APlayerMech::Look(const FInputActionValue& Value)
 {
 	FVector2D LookAxisVector = Value.Get<FVector2D>();
 
-	if (Controller != nullptr)
+	if (Controller != nullptr && IsLocallyControlled())
 	{
 		// add yaw and pitch input to controller
 		AddControllerYawInput(LookAxisVector.X * 40.0f * GetWorld()->GetDeltaSeconds());
@@ -202,18 +553,28 @@ void APlayerMech::Look(const FInputActionValue& Value)
 void APlayerMech::EndBoost()
 {
 	bIsBoosting = false;
+	GetMechMovement()->SetWantsToBoost(false);
+	UpdateBoostEnergyRate();
 }
 
 void APlayerMech::Dash()
 {
-	if (BoostEnergy <= 10.0f)
+	if (GetBoostEnergy() <= GetTuning().MinDashEnergy)
 		return;
 		
 	if (!bIsMovementInput)
 	{
+		if (!TurnDashTimeline || !IsLocallyControlled())
+			return;
+
 		StartingControlRotation = GetControlRotation();
 		TurnLookValueX = LookValueX;
 		TurnDashTimeline->PlayFromStart();
+
+		if (MechTelemetry::IsActive())
+		{
+			RecordTelemetry(EMechTelemetryEvent::Dash, EMechDashType::Turn, GetBoostEnergy(), GetVelocity().Size2D());
+		}
 	}
 	else
 	{
@@ -239,34 +600,13 @@ void APlayerMech::ForwardBackDash()
 	if (!bIsValidForwardDash)
 		return;
 
-	BoostEnergy = BoostEnergy - 10.f;
-
-	FVector XVector = GetActorRotation().Vector() * 15000.0f;
 	float Direction = MoveValueY >= 0.0f ? 1.0f : -1.0f;
-	LaunchCharacter(FVector(XVector.X * Direction, XVector.Y * Direction, 20.0f), false, false);
-
-	// Clamp velocity like SideDash
-	ClampCharacterVelocity();
-
-	bIsValidForwardDash = false;
-	bIsValidSideDash = false;
-
-	// Use timer to reset dash flags after 1 second
-	GetWorld()->GetTimerManager().ClearTimer(DashCooldownTimer);
-	GetWorld()->GetTimerManager().SetTimer(DashCooldownTimer, [this]()
-	{
-		bIsValidForwardDash = true;
-		bIsValidSideDash = true;
-		bIsValidRightDash = true;
-		bIsValidLeftDash = true;
-	}, 1.0f, false);
+	PerformDashLaunch(GetActorForwardVector() * Direction, GetTuning().ForwardDashSpeed, Direction > 0.f ? EMechDashType::Forward : EMechDashType::Back, true);
 }
 
-
-
 void APlayerMech::UpdateTurnDash(float Value)
 {
-	float NewValue = Value * 90.0f * (TurnLookValueX >= 0.f ? 1.0f : -1.0f);
+	float NewValue = Value * GetTuning().TurnDashAngle * (TurnLookValueX >= 0.f ? 1.0f : -1.0f);
 	FRotator NewRotation = FRotator(0.f, NewValue + StartingControlRotation.Yaw, 0.f);
 
 	if (APlayerController* PC = Cast<APlayerController>(GetController()))
@@ -275,24 +615,10 @@ void APlayerMech::UpdateTurnDash(float Value)
 	}
 }
 
-void APlayerMech::UpdateVelocityDamping(float Value)
-{
-	FVector CurVelocity = GetCharacterMovement()->Velocity;
-	float NewVelocityX = FMath::Clamp(CurVelocity.X, -24000.0f, 24000.0f);
-	float NewVelocityY = FMath::Clamp(CurVelocity.Y, -24000.0f, 24000.0f);
-	float NewVelocityZ = FMath::Clamp(CurVelocity.Z, -24000.0f, 24000.0f);
-	GetCharacterMovement()->Velocity = FMath::Lerp(CurVelocity, FVector(NewVelocityX, NewVelocityY, NewVelocityZ), Value);
-}
-
-void APlayerMech::FinishedVelocityDamping()
-{
-	// Velocity damping finished, but dash cooldown is handled by timer
-}
-
 void APlayerMech::SideDash()
 {
-	VelocityDampingTimeline->Stop();
-	
+	const FVector SideDirection = GetActorRightVector() * (MoveValueX >= 0.0f ? 1.0f : -1.0f);
+
 	if (MoveValueX > 0.f) // Right dash
 	{
 		if (bIsValidRightDash)
@@ -307,7 +633,7 @@ void APlayerMech::SideDash()
 				GetCharacterMovement()->Velocity = UKismetMathLibrary::GreaterGreater_VectorRotator(InvertedYVelocity, GetActorRotation());
 				
 				// Perform dash with energy consumption
-				PerformDashLaunch(12000.f, true);
+				PerformDashLaunch(SideDirection, GetTuning().SideDashReverseSpeed, EMechDashType::SideReverse, true);
 			}
 			else
 			{
@@ -316,7 +642,7 @@ void APlayerMech::SideDash()
 				bIsValidLeftDash = true;
 				
 				// Perform dash without energy consumption
-				PerformDashLaunch(15000.f, false);
+				PerformDashLaunch(SideDirection, GetTuning().SideDashSpeed, EMechDashType::Side, false);
 			}
 		}
 	}
@@ -334,7 +660,7 @@ void APlayerMech::SideDash()
 				GetCharacterMovement()->Velocity = UKismetMathLibrary::GreaterGreater_VectorRotator(InvertedYVelocity, GetActorRotation());
 				
 				// Perform dash with energy consumption
-				PerformDashLaunch(12000.f, true);
+				PerformDashLaunch(SideDirection, GetTuning().SideDashReverseSpeed, EMechDashType::SideReverse, true);
 			}
 			else
 			{
@@ -343,41 +669,48 @@ void APlayerMech::SideDash()
 				bIsValidLeftDash = false;
 				
 				// Perform dash without energy consumption
-				PerformDashLaunch(15000.f, false);
+				PerformDashLaunch(SideDirection, GetTuning().SideDashSpeed, EMechDashType::Side, false);
 			}
 		}
 	}
 }
 
-void APlayerMech::PerformDashLaunch(float VelocityMultiplier, bool bConsumeEnergy)
+void APlayerMech::PerformDashLaunch(const FVector& Direction, float Impulse, EMechDashType DashType, bool bConsumeEnergy)
 {
+	const UMechTuningData& Tuning = GetTuning();
+	const bool bRecordTelemetry = MechTelemetry::IsActive();
+	const float EnergyBefore = bRecordTelemetry ? GetBoostEnergy() : 0.f;
+
 	if (bConsumeEnergy)
 	{
-		BoostEnergy -= 10.0f;
+		// Spending while boosting moves the scheduled depletion earlier
+		BoostEnergyState.Add(GetEnergyTime(), -Tuning.DashEnergyCost);
+		UpdateBoostEnergyRate();
 	}
-	
-	FRotator ComposedRotator = UKismetMathLibrary::ComposeRotators(GetActorRotation(), FRotator(0.f, 90.f, 0.f));
-	float DirectionMultiplier = MoveValueX >= 0.0f ? 1.0f : -1.0f;
-	float LaunchVelocityX = ComposedRotator.Pitch * VelocityMultiplier * DirectionMultiplier;
-	float LaunchVelocityY = ComposedRotator.Yaw * VelocityMultiplier * DirectionMultiplier;
-	
-	LaunchCharacter(FVector(LaunchVelocityX, LaunchVelocityY, 20.0f), false, false);
-	
-	ClampCharacterVelocity();
-	SetupPostDashState();
-}
 
-void APlayerMech::ClampCharacterVelocity()
-{
-	GetCharacterMovement()->Velocity = FVector(
-		FMath::Clamp(GetCharacterMovement()->Velocity.X, -2000.0f, 2000.0f),
-		FMath::Clamp(GetCharacterMovement()->Velocity.Y, -2000.0f, 2000.0f),
-		FMath::Clamp(GetCharacterMovement()->Velocity.Z, -2000.0f, 2000.0f)
-	);
+	// The dash movement mode limits the result and brakes it; no launch-then-clamp
+	UMechMovementComponent* MechMovement = GetMechMovement();
+	FVector DashVelocity = MechMovement->Velocity + Direction * Impulse;
+	DashVelocity.Z = MechMovement->Velocity.Z + Tuning.DashLiftVelocity;
+	const bool bLimited = CVarMechLegacyDash.GetValueOnGameThread() ? MechMovement->LaunchDashLegacy(DashVelocity) : MechMovement->StartDash(DashVelocity);
+
+	if (bRecordTelemetry)
+	{
+		// The dash starts with the next movement update, so log the speed it will start at
+		RecordTelemetry(EMechTelemetryEvent::Dash, DashType, EnergyBefore, FMath::Min(DashVelocity.Size2D(), Tuning.DashVelocityLimit));
+		if (bLimited)
+		{
+			RecordTelemetry(EMechTelemetryEvent::DashClamped, DashType, EnergyBefore, DashVelocity.Size2D());
+		}
+	}
+
+	SetupPostDashState();
 }
 
 void APlayerMech::SetupPostDashState()
 {
+	const UMechTuningData& Tuning = GetTuning();
+
 	bIsValidForwardDash = false;
 	bIsValidSideDash = false;
 	
@@ -389,5 +722,5 @@ void APlayerMech::SetupPostDashState()
 		bIsValidSideDash = true;
 		bIsValidRightDash = true;
 		bIsValidLeftDash = true;
-	}, 1.0f, false);
+	}, Tuning.DashCooldown, false);
 }
@@ -0,0 +1,508 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/MechMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "Data/MechTuningData.h"
+#include "../../ProjectMC.h"
+
+DECLARE_CYCLE_STAT(TEXT("Mech Movement Tick"), STAT_MechMovementTick, STATGROUP_ProjectMC);
+DECLARE_CYCLE_STAT(TEXT("Mech Phys Boost"), STAT_MechPhysBoost, STATGROUP_ProjectMC);
+DECLARE_CYCLE_STAT(TEXT("Mech Phys Dash"), STAT_MechPhysDash, STATGROUP_ProjectMC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mech Movement Sweeps"), STAT_MechMovementSweeps, STATGROUP_ProjectMC);
+
+/** Saved move carrying boost and dash requests so clients predict them like the server and replay them after corrections */
+class FSavedMove_Mech : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	FSavedMove_Mech()
+		: bSavedWantsToBoost(false)
+		, bSavedWantsToDash(false)
+	{
+	}
+
+	virtual void Clear() override
+	{
+		Super::Clear();
+		bSavedWantsToBoost = false;
+		bSavedWantsToDash = false;
+		SavedDashVelocity = FVector::ZeroVector;
+		SavedDashTimeRemaining = 0.f;
+	}
+
+	virtual uint8 GetCompressedFlags() const override
+	{
+		uint8 Result = Super::GetCompressedFlags();
+		if (bSavedWantsToBoost)
+		{
+			Result |= FLAG_Custom_0;
+		}
+		if (bSavedWantsToDash)
+		{
+			Result |= FLAG_Custom_1;
+		}
+		return Result;
+	}
+
+	virtual bool IsImportantMove(const FSavedMovePtr& LastAckedMove) const override
+	{
+		// A dash request must reach the server even if later moves are dropped
+		return bSavedWantsToDash || Super::IsImportantMove(LastAckedMove);
+	}
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override
+	{
+		const FSavedMove_Mech* NewMechMove = static_cast<FSavedMove_Mech*>(NewMove.Get());
+		if (bSavedWantsToBoost != NewMechMove->bSavedWantsToBoost || bSavedWantsToDash || NewMechMove->bSavedWantsToDash)
+		{
+			return false;
+		}
+		return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+	}
+
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override
+	{
+		Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+		if (const UMechMovementComponent* MechMovement = Cast<UMechMovementComponent>(C->GetCharacterMovement()))
+		{
+			bSavedWantsToBoost = MechMovement->bWantsToBoost;
+			bSavedWantsToDash = MechMovement->bWantsToDash;
+			SavedDashVelocity = MechMovement->PendingDashVelocity;
+			SavedDashTimeRemaining = MechMovement->DashTimeRemaining;
+		}
+	}
+
+	virtual void PrepMoveFor(ACharacter* C) override
+	{
+		Super::PrepMoveFor(C);
+		if (UMechMovementComponent* MechMovement = Cast<UMechMovementComponent>(C->GetCharacterMovement()))
+		{
+			// Corrections don't carry the dash timer, so replays restore it from when the move was made
+			MechMovement->bWantsToBoost = bSavedWantsToBoost;
+			MechMovement->bWantsToDash = bSavedWantsToDash;
+			MechMovement->PendingDashVelocity = SavedDashVelocity;
+			MechMovement->DashTimeRemaining = SavedDashTimeRemaining;
+		}
+	}
+
+	uint8 bSavedWantsToBoost : 1;
+
+	uint8 bSavedWantsToDash : 1;
+
+	FVector SavedDashVelocity = FVector::ZeroVector;
+
+	float SavedDashTimeRemaining = 0.f;
+};
+
+void FMechNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+	DashVelocity = static_cast<const FSavedMove_Mech&>(ClientMove).SavedDashVelocity;
+}
+
+bool FMechNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// Only moves that start a dash pay for the velocity
+	if (CompressedMoveFlags & FSavedMove_Character::FLAG_Custom_1)
+	{
+		SerializePackedVector<10, 24>(DashVelocity, Ar);
+	}
+
+	return !Ar.IsError();
+}
+
+class FNetworkPredictionData_Client_Mech : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_Mech(const UCharacterMovementComponent& ClientMovement)
+		: Super(ClientMovement)
+	{
+	}
+
+	virtual FSavedMovePtr AllocateNewMove() override
+	{
+		return FSavedMovePtr(new FSavedMove_Mech());
+	}
+};
+
+UMechMovementComponent::UMechMovementComponent()
+{
+	bWantsToBoost = false;
+	bBoostJumping = false;
+	bWantsToDash = false;
+	bClampPendingLaunch = false;
+
+	SetNetworkMoveDataContainer(MechMoveDataContainer);
+}
+
+void UMechMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// Mechs don't tick as actors, so this is where their per-frame cost shows up with stat ProjectMC
+	SCOPE_CYCLE_COUNTER(STAT_MechMovementTick);
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+const UMechTuningData& UMechMovementComponent::GetTuning() const
+{
+	return Tuning ? *Tuning : *GetDefault<UMechTuningData>();
+}
+
+bool UMechMovementComponent::StartDash(const FVector& DashVelocity)
+{
+	PendingDashVelocity = DashVelocity;
+	bWantsToDash = true;
+	return LimitDashVelocity(PendingDashVelocity);
+}
+
+bool UMechMovementComponent::LaunchDashLegacy(const FVector& DashVelocity)
+{
+	const float Limit = GetTuning().DashVelocityLimit;
+	if (CharacterOwner)
+	{
+		CharacterOwner->LaunchCharacter(DashVelocity, true, true);
+		bClampPendingLaunch = true;
+	}
+	return FMath::Abs(DashVelocity.X) > Limit || FMath::Abs(DashVelocity.Y) > Limit;
+}
+
+bool UMechMovementComponent::LimitDashVelocity(FVector& DashVelocity) const
+{
+	const UMechTuningData& MechTuning = GetTuning();
+
+	// Limit by magnitude so diagonal dashes aren't faster than straight ones
+	const float HorizontalSizeSquared = DashVelocity.SizeSquared2D();
+	if (HorizontalSizeSquared <= MechTuning.DashVelocityLimitSquared)
+	{
+		return false;
+	}
+
+	const float Scale = MechTuning.DashVelocityLimit * FMath::InvSqrt(HorizontalSizeSquared);
+	DashVelocity.X *= Scale;
+	DashVelocity.Y *= Scale;
+	return true;
+}
+
+void UMechMovementComponent::EnterDash()
+{
+	bWantsToDash = false;
+
+	// The server limits again rather than trusting the client's velocity
+	Velocity = PendingDashVelocity;
+	LimitDashVelocity(Velocity);
+
+	// Dashing again mid-dash doesn't change the mode, so restart the timer here as well
+	DashTimeRemaining = GetTuning().DashDuration;
+	SetMovementMode(MOVE_Custom, static_cast<uint8>(EMechMovementMode::Dash));
+}
+
+void UMechMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	const FFindFloorResult PreviousFloor = CurrentFloor;
+	const bool bWasOnGround = PreviousMovementMode == MOVE_Walking || PreviousMovementMode == MOVE_NavWalking
+		|| (PreviousMovementMode == MOVE_Custom && PreviousCustomMode == static_cast<uint8>(EMechMovementMode::Boost));
+	const bool bWasDashing = PreviousMovementMode == MOVE_Custom && PreviousCustomMode == static_cast<uint8>(EMechMovementMode::Dash);
+
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	// The timer starts here rather than in EnterDash so simulated proxies, which only get the
+	// replicated mode, time their dashes too
+	if (IsDashing() && !bWasDashing)
+	{
+		DashTimeRemaining = GetTuning().DashDuration;
+
+		// Leaving walking cleared the floor, but a ground dash still stands on it; without it the
+		// first step would fall into the floor and spend its slide sweep getting back out
+		if (bWasOnGround)
+		{
+			CurrentFloor = PreviousFloor;
+		}
+	}
+	else if (!IsDashing())
+	{
+		DashTimeRemaining = 0.f;
+	}
+}
+
+float UMechMovementComponent::GetMaxSpeed() const
+{
+	if (IsBoostMoving() || (bWantsToBoost && IsFalling()))
+	{
+		return GetTuning().BoostSpeed;
+	}
+
+	if (IsDashing())
+	{
+		return GetTuning().DashVelocityLimit;
+	}
+
+	return Super::GetMaxSpeed();
+}
+
+float UMechMovementComponent::GetMaxBrakingDeceleration() const
+{
+	if (IsBoostMoving())
+	{
+		return GetTuning().BoostBrakingDeceleration;
+	}
+
+	if (IsDashing())
+	{
+		return GetTuning().DashBrakingDeceleration;
+	}
+
+	// With no braking and no input, the over-max-speed clamp in CalcVelocity has nothing to apply
+	if (bBoostJumping && IsFalling())
+	{
+		return 0.f;
+	}
+
+	return Super::GetMaxBrakingDeceleration();
+}
+
+bool UMechMovementComponent::IsMovingOnGround() const
+{
+	return Super::IsMovingOnGround() || (IsBoostMoving() && UpdatedComponent);
+}
+
+void UMechMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	if (bWantsToDash)
+	{
+		EnterDash();
+	}
+
+	if (bWantsToBoost && MovementMode == MOVE_Walking)
+	{
+		SetMovementMode(MOVE_Custom, static_cast<uint8>(EMechMovementMode::Boost));
+	}
+	else if (!bWantsToBoost && IsBoostMoving())
+	{
+		SetMovementMode(MOVE_Walking);
+	}
+}
+
+void UMechMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	bWantsToBoost = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+	bWantsToDash = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
+
+	// On the server the velocity comes with the client's move; replays already restored it in PrepMoveFor
+	if (bWantsToDash)
+	{
+		if (const FCharacterNetworkMoveData* MoveData = GetCurrentNetworkMoveData())
+		{
+			PendingDashVelocity = static_cast<const FMechNetworkMoveData*>(MoveData)->DashVelocity;
+		}
+	}
+}
+
+FNetworkPredictionData_Client* UMechMovementComponent::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UMechMovementComponent* MutableThis = const_cast<UMechMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Mech(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+bool UMechMovementComponent::HandlePendingLaunch()
+{
+	if (!Super::HandlePendingLaunch())
+	{
+		return false;
+	}
+
+	if (bClampPendingLaunch)
+	{
+		bClampPendingLaunch = false;
+		const float Limit = GetTuning().DashVelocityLimit;
+		Velocity = Velocity.BoundToBox(FVector(-Limit), FVector(Limit));
+	}
+
+	return true;
+}
+
+void UMechMovementComponent::SetPostLandedPhysics(const FHitResult& Hit)
+{
+	Super::SetPostLandedPhysics(Hit);
+
+	bBoostJumping = false;
+
+	if (bWantsToBoost && MovementMode == MOVE_Walking)
+	{
+		SetMovementMode(MOVE_Custom, static_cast<uint8>(EMechMovementMode::Boost));
+	}
+}
+
+void UMechMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
+{
+	switch (static_cast<EMechMovementMode>(CustomMovementMode))
+	{
+	case EMechMovementMode::Boost:
+		PhysBoost(DeltaTime, Iterations);
+		break;
+	case EMechMovementMode::Dash:
+		PhysDash(DeltaTime, Iterations);
+		break;
+	default:
+		Super::PhysCustom(DeltaTime, Iterations);
+		break;
+	}
+}
+
+void UMechMovementComponent::PhysBoost(float DeltaTime, int32 Iterations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MechPhysBoost);
+
+	if (DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	if (!CharacterOwner || (!CharacterOwner->Controller && !bRunPhysicsWithNoController && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity() && (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)))
+	{
+		Acceleration = FVector::ZeroVector;
+		Velocity = FVector::ZeroVector;
+		return;
+	}
+
+	const UMechTuningData& MechTuning = GetTuning();
+	float RemainingTime = DeltaTime;
+
+	while (RemainingTime >= MIN_TICK_TIME && Iterations < MaxSimulationIterations && CharacterOwner && IsBoostMoving())
+	{
+		++Iterations;
+		const float TimeTick = GetSimulationTimeStep(RemainingTime, Iterations);
+		RemainingTime -= TimeTick;
+
+		const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+
+		// Boost integrates on the ground plane with its own friction and braking
+		Acceleration.Z = 0.f;
+		Velocity.Z = 0.f;
+		CalcVelocity(TimeTick, MechTuning.BoostFriction, false, GetMaxBrakingDeceleration());
+
+		FHitResult Hit(1.f);
+		MoveWithSweepBudget(Velocity * TimeTick, MaxBoostSweeps, true, Hit);
+
+		FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
+		if (!CurrentFloor.IsWalkableFloor())
+		{
+			// Boosting off a ledge carries the boost velocity into the fall
+			SetMovementMode(MOVE_Falling);
+			StartNewPhysics(RemainingTime, Iterations);
+			return;
+		}
+
+		AdjustFloorHeight();
+		SetBaseFromFloor(CurrentFloor);
+
+		// Keep only the velocity actually achieved so a blocked mech doesn't build phantom speed
+		Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / TimeTick;
+		MaintainHorizontalGroundVelocity();
+	}
+}
+
+void UMechMovementComponent::PhysDash(float DeltaTime, int32 Iterations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MechPhysDash);
+
+	if (DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	float RemainingTime = DeltaTime;
+
+	while (RemainingTime >= MIN_TICK_TIME && Iterations < MaxSimulationIterations && CharacterOwner && IsDashing())
+	{
+		++Iterations;
+		const float TimeTick = FMath::Min(GetSimulationTimeStep(RemainingTime, Iterations), FMath::Max(DashTimeRemaining, MIN_TICK_TIME));
+		RemainingTime -= TimeTick;
+		DashTimeRemaining -= TimeTick;
+
+		// The dash velocity is set once in StartDash and only braked from then on
+		const FVector HorizontalVelocity(Velocity.X, Velocity.Y, 0.f);
+		const float Speed = HorizontalVelocity.Size();
+		const float BrakedSpeed = FMath::Max(Speed - GetMaxBrakingDeceleration() * TimeTick, 0.f);
+		const FVector BrakedVelocity = Speed > UE_KINDA_SMALL_NUMBER ? HorizontalVelocity * (BrakedSpeed / Speed) : FVector::ZeroVector;
+
+		const bool bOnFloor = CurrentFloor.IsWalkableFloor() && Velocity.Z <= 0.f;
+		Velocity = FVector(BrakedVelocity.X, BrakedVelocity.Y, bOnFloor ? 0.f : Velocity.Z + GetGravityZ() * TimeTick);
+
+		FHitResult Hit(1.f);
+		MoveWithSweepBudget(Velocity * TimeTick, MaxDashSweeps, bOnFloor, Hit);
+
+		if (Hit.IsValidBlockingHit() && (Velocity | Hit.Normal) < 0.f)
+		{
+			// Don't keep pushing into whatever stopped the dash
+			Velocity = FVector::VectorPlaneProject(Velocity, Hit.Normal);
+		}
+
+		FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
+		if (CurrentFloor.IsWalkableFloor() && Velocity.Z <= 0.f)
+		{
+			AdjustFloorHeight();
+			SetBaseFromFloor(CurrentFloor);
+			Velocity.Z = 0.f;
+		}
+
+		if (DashTimeRemaining <= 0.f)
+		{
+			ExitToGroundOrAir(RemainingTime, Iterations);
+			return;
+		}
+	}
+}
+
+void UMechMovementComponent::MoveWithSweepBudget(const FVector& Delta, int32 MaxSweeps, bool bAllowStepUp, FHitResult& OutHit)
+{
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, OutHit);
+	int32 NumSweeps = 1;
+
+	if (OutHit.IsValidBlockingHit() && NumSweeps < MaxSweeps)
+	{
+		const FVector RemainingDelta = Delta * (1.f - OutHit.Time);
+		const bool bSteppedUp = bAllowStepUp && !IsWalkable(OutHit) && CanStepUp(OutHit) && StepUp(FVector(0.f, 0.f, -1.f), RemainingDelta, OutHit);
+		if (!bSteppedUp)
+		{
+			SlideAlongSurface(Delta, 1.f - OutHit.Time, OutHit.Normal, OutHit, true);
+		}
+		++NumSweeps;
+	}
+
+	INC_DWORD_STAT_BY(STAT_MechMovementSweeps, NumSweeps);
+}
+
+void UMechMovementComponent::ExitToGroundOrAir(float RemainingTime, int32 Iterations)
+{
+	if (CurrentFloor.IsWalkableFloor() && Velocity.Z <= 0.f)
+	{
+		if (bWantsToBoost)
+		{
+			SetMovementMode(MOVE_Custom, static_cast<uint8>(EMechMovementMode::Boost));
+		}
+		else
+		{
+			SetMovementMode(MOVE_Walking);
+		}
+	}
+	else
+	{
+		SetMovementMode(MOVE_Falling);
+	}
+
+	StartNewPhysics(RemainingTime, Iterations);
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/MechTuningData.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "../../ProjectMC.h"
+
+const FPrimaryAssetType UMechTuningData::PrimaryAssetType = TEXT("MechTuning");
+
+FPrimaryAssetId UMechTuningData::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+void UMechTuningData::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// The class default object doubles as the fallback tuning for mechs without an asset
+	RecomputeDerivedValues();
+}
+
+void UMechTuningData::PostLoad()
+{
+	Super::PostLoad();
+
+	RecomputeDerivedValues();
+}
+
+#if WITH_EDITOR
+void UMechTuningData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	NotifyTuningChanged();
+}
+#endif
+
+void UMechTuningData::NotifyTuningChanged()
+{
+	RecomputeDerivedValues();
+	OnTuningChanged.Broadcast(this);
+}
+
+void UMechTuningData::RecomputeDerivedValues()
+{
+	DashVelocityLimitSquared = FMath::Square(DashVelocityLimit);
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand CmdMechTune(
+	TEXT("mc.Mech.Tune"),
+	TEXT("Live-tunes a float on a mech tuning asset and pushes it to every mech using it. Default__MechTuningData targets mechs without an asset. Usage: mc.Mech.Tune <AssetName> <Property> <Value>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 3)
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("Usage: mc.Mech.Tune <AssetName> <Property> <Value>"));
+			return;
+		}
+
+		FFloatProperty* Property = FindFProperty<FFloatProperty>(UMechTuningData::StaticClass(), FName(*Args[1]));
+		if (!Property)
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("mc.Mech.Tune: '%s' is not a float property of UMechTuningData"), *Args[1]);
+			return;
+		}
+
+		const float NewValue = FCString::Atof(*Args[2]);
+		// Include the class default object, which mechs without an asset fall back to
+		for (TObjectIterator<UMechTuningData> It(RF_NoFlags); It; ++It)
+		{
+			if (It->GetName() == Args[0])
+			{
+				Property->SetPropertyValue_InContainer(*It, NewValue);
+				It->NotifyTuningChanged();
+				UE_LOG(LogProjectMC, Log, TEXT("mc.Mech.Tune: %s.%s = %f"), *Args[0], *Args[1], NewValue);
+			}
+		}
+	}));
+#endif
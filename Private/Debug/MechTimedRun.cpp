@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Debug/MechTimedRun.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "../../ProjectMC.h"
+
+#if !UE_BUILD_SHIPPING
+
+static TUniquePtr<FMechTimedRun> ActiveRun;
+
+FMechTimedRun::FMechTimedRun(const TCHAR* InExitParam, float InDuration)
+	: ExitParam(InExitParam)
+	, Duration(InDuration)
+{
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMechTimedRun::Tick));
+}
+
+FMechTimedRun::~FMechTimedRun()
+{
+	// A finished run has already removed itself from the ticker
+	if (!bFinished)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	}
+}
+
+bool FMechTimedRun::CanStart(const TCHAR* Command)
+{
+	if (ActiveRun && !ActiveRun->IsFinished())
+	{
+		UE_LOG(LogProjectMC, Warning, TEXT("%s: another timed run is still going"), Command);
+		return false;
+	}
+	return true;
+}
+
+void FMechTimedRun::Start(TUniquePtr<FMechTimedRun> Run)
+{
+	check(!ActiveRun || ActiveRun->IsFinished());
+	ActiveRun = MoveTemp(Run);
+}
+
+bool FMechTimedRun::Tick(float DeltaTime)
+{
+	if (Elapsed >= Duration)
+	{
+		Finish();
+		return false;
+	}
+
+	// The first frame's delta covers the console command itself
+	if (bStarted)
+	{
+		Elapsed += DeltaTime;
+		WorstFrameSeconds = FMath::Max(WorstFrameSeconds, DeltaTime);
+		if (DeltaTime > HitchSeconds)
+		{
+			++NumHitches;
+		}
+		++NumFrames;
+	}
+	bStarted = true;
+
+	if (!TickRun(DeltaTime))
+	{
+		Finish();
+		return false;
+	}
+	return true;
+}
+
+void FMechTimedRun::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+	bFinished = true;
+
+	FinishRun();
+
+	if (FParse::Param(FCommandLine::Get(), ExitParam))
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void FMechTimedRun::LogFrameStats() const
+{
+	UE_LOG(LogProjectMC, Log, TEXT("  %d frames, average %.2f ms, worst %.1f ms, %d hitches over %.0f ms"),
+		NumFrames, GetAverageFrameSeconds() * 1000.f, WorstFrameSeconds * 1000.f, NumHitches, HitchSeconds * 1000.f);
+}
+
+#endif
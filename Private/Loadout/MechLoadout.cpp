@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Loadout/MechLoadout.h"
+#include "Data/MechTuningData.h"
+
+bool FMechLoadout::IsComplete() const
+{
+	for (const UMechPartData* Part : Parts)
+	{
+		if (!Part)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FMechLoadout::SetPart(UMechPartData* Part)
+{
+	if (!Part)
+	{
+		return;
+	}
+
+	UMechPartData*& Current = Parts[static_cast<int32>(Part->Slot)];
+	if (Current)
+	{
+		Stats -= Current->Stats;
+	}
+	Stats += Part->Stats;
+	Current = Part;
+}
+
+void FMechLoadout::ClearPart(EMechPartSlot Slot)
+{
+	UMechPartData*& Current = Parts[static_cast<int32>(Slot)];
+	if (Current)
+	{
+		Stats -= Current->Stats;
+	}
+	Current = nullptr;
+}
+
+void FMechLoadout::RefreshStats()
+{
+	Stats = FMechPartStats();
+	for (const UMechPartData* Part : Parts)
+	{
+		if (Part)
+		{
+			Stats += Part->Stats;
+		}
+	}
+}
+
+void FMechLoadout::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		RefreshStats();
+	}
+}
+
+void FMechLoadout::ApplyToTuning(const UMechTuningData& Base, UMechTuningData& Out) const
+{
+	const FMechPartStats& Totals = Stats;
+
+	// Heavier builds are slower per unit of thrust; overweight builds also lose walking speed
+	const float Weight = FMath::Max(Totals.Weight, 1.f);
+	const float MassScale = Base.LoadoutReferenceWeight / Weight;
+	const float Mobility = FMath::Clamp(Totals.LoadCapacity / Weight, 0.5f, 1.f);
+
+	Out.NormalSpeed = Base.NormalSpeed * Mobility;
+	Out.BoostSpeed = Totals.BoostThrust * MassScale;
+	Out.MechJumpVelocity = Totals.JumpThrust * FMath::Sqrt(MassScale);
+	Out.ForwardDashSpeed = Totals.DashThrust * MassScale;
+	Out.SideDashSpeed = Out.ForwardDashSpeed;
+	Out.SideDashReverseSpeed = Out.ForwardDashSpeed * Base.SideDashReverseSpeed / FMath::Max(Base.SideDashSpeed, 1.f);
+	Out.DashVelocityLimit = Base.DashVelocityLimit * Mobility;
+
+	Out.MaxBoostEnergy = Totals.EnergyCapacity;
+	Out.BoostDepleteRate = Totals.BoostConsumption;
+	Out.BoostRegenRate = FMath::Max(Totals.EnergyOutput - Totals.EnergyDrain, Base.LoadoutMinRegenRate);
+}
+
+bool FMechLoadout::IsLoadoutDriven(const FProperty& Property)
+{
+	// Keep in sync with ApplyToTuning
+	static const FName LoadoutDrivenNames[] =
+	{
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, NormalSpeed),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, BoostSpeed),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, MechJumpVelocity),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, ForwardDashSpeed),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, SideDashSpeed),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, SideDashReverseSpeed),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, DashVelocityLimit),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, MaxBoostEnergy),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, BoostDepleteRate),
+		GET_MEMBER_NAME_CHECKED(UMechTuningData, BoostRegenRate),
+	};
+
+	for (const FName& Name : LoadoutDrivenNames)
+	{
+		if (Property.GetFName() == Name)
+		{
+			return true;
+		}
+	}
+	return false;
+}
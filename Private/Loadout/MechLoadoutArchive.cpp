@@ -0,0 +1,234 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Loadout/MechLoadoutArchive.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "../../ProjectMC.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Loadout files are written in native byte order and assume little endian");
+
+namespace MechLoadoutArchive
+{
+	static void Append(TArray<uint8>& Buffer, const void* Bytes, int32 NumBytes)
+	{
+		Buffer.Append(static_cast<const uint8*>(Bytes), NumBytes);
+	}
+
+	bool Save(const FString& Filename, TConstArrayView<FMechSavedBuild> Builds)
+	{
+		TArray<uint8> PartTable;
+		TArray<uint8> NameBlob;
+		TArray<FMechLoadoutBuildRecord> Records;
+		TMap<FPrimaryAssetId, uint16> PartIndices;
+		Records.Reserve(Builds.Num());
+
+		for (const FMechSavedBuild& Build : Builds)
+		{
+			FMechLoadoutBuildRecord& Record = Records.AddDefaulted_GetRef();
+			Record.NameOffset = NameBlob.Num();
+
+			FTCHARToUTF8 Name(*Build.Name);
+			Append(NameBlob, Name.Get(), Name.Length());
+			NameBlob.Add(0);
+
+			for (int32 SlotIndex = 0; SlotIndex < NumMechPartSlots; ++SlotIndex)
+			{
+				const FPrimaryAssetId& PartId = Build.Parts[SlotIndex];
+				if (!PartId.IsValid())
+				{
+					Record.PartIndices[SlotIndex] = NoPart;
+					continue;
+				}
+
+				if (const uint16* ExistingIndex = PartIndices.Find(PartId))
+				{
+					Record.PartIndices[SlotIndex] = *ExistingIndex;
+					continue;
+				}
+
+				if (PartIndices.Num() >= NoPart)
+				{
+					UE_LOG(LogProjectMC, Error, TEXT("Too many distinct parts to save loadouts to %s"), *Filename);
+					return false;
+				}
+
+				const uint16 NewIndex = static_cast<uint16>(PartIndices.Num());
+				PartIndices.Add(PartId, NewIndex);
+				Record.PartIndices[SlotIndex] = NewIndex;
+
+				FTCHARToUTF8 PartString(*PartId.ToString());
+				const uint16 Length = static_cast<uint16>(PartString.Length());
+				Append(PartTable, &Length, sizeof(Length));
+				Append(PartTable, PartString.Get(), Length);
+			}
+		}
+
+		// Keep the build records 4-byte aligned within the file so they can be read in place
+		const int32 UnpaddedSize = sizeof(FMechLoadoutFileHeader) + PartTable.Num() + NameBlob.Num();
+		NameBlob.AddZeroed(Align(UnpaddedSize, 4) - UnpaddedSize);
+
+		FMechLoadoutFileHeader Header;
+		Header.Magic = Magic;
+		Header.Version = CurrentVersion;
+		Header.NumSlots = NumMechPartSlots;
+		Header.NumParts = PartIndices.Num();
+		Header.PartTableSize = PartTable.Num();
+		Header.NameBlobSize = NameBlob.Num();
+		Header.NumBuilds = Records.Num();
+
+		TArray<uint8> Buffer;
+		Buffer.Reserve(sizeof(Header) + PartTable.Num() + NameBlob.Num() + Records.Num() * sizeof(FMechLoadoutBuildRecord));
+		Append(Buffer, &Header, sizeof(Header));
+		Buffer.Append(PartTable);
+		Buffer.Append(NameBlob);
+		Append(Buffer, Records.GetData(), Records.Num() * sizeof(FMechLoadoutBuildRecord));
+
+		return FFileHelper::SaveArrayToFile(Buffer, *Filename);
+	}
+}
+
+FMechLoadoutArchiveReader::FMechLoadoutArchiveReader() = default;
+
+FMechLoadoutArchiveReader::~FMechLoadoutArchiveReader() = default;
+
+bool FMechLoadoutArchiveReader::Open(const FString& Filename)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedHandle.Reset(PlatformFile.OpenMapped(*Filename));
+	if (MappedHandle)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion());
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		MappedHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackData, *Filename, FILEREAD_Silent))
+		{
+			return false;
+		}
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+
+	if (!Parse())
+	{
+		UE_LOG(LogProjectMC, Warning, TEXT("%s is not a valid loadout file"), *Filename);
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void FMechLoadoutArchiveReader::Close()
+{
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	FallbackData.Empty();
+	Data = nullptr;
+	DataSize = 0;
+	PartIds.Reset();
+	NameBlob = nullptr;
+	NameBlobSize = 0;
+	BuildRecords = nullptr;
+	NumBuildRecords = 0;
+}
+
+bool FMechLoadoutArchiveReader::Parse()
+{
+	if (DataSize < static_cast<int64>(sizeof(FMechLoadoutFileHeader)))
+	{
+		return false;
+	}
+
+	FMechLoadoutFileHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+	// Older versions would be upgraded here; there is only one so far
+	if (Header.Magic != MechLoadoutArchive::Magic || Header.Version != MechLoadoutArchive::CurrentVersion || Header.NumSlots != NumMechPartSlots)
+	{
+		return false;
+	}
+
+	const int64 PartTableOffset = sizeof(FMechLoadoutFileHeader);
+	const int64 NameBlobOffset = PartTableOffset + Header.PartTableSize;
+	const int64 BuildsOffset = NameBlobOffset + Header.NameBlobSize;
+	if (BuildsOffset % 4 != 0 || BuildsOffset + static_cast<int64>(Header.NumBuilds) * sizeof(FMechLoadoutBuildRecord) > DataSize)
+	{
+		return false;
+	}
+
+	// The part table is small and every build refers to it, so decode it once up front
+	PartIds.Reserve(Header.NumParts);
+	int64 Cursor = PartTableOffset;
+	for (uint32 PartIndex = 0; PartIndex < Header.NumParts; ++PartIndex)
+	{
+		uint16 Length = 0;
+		if (Cursor + static_cast<int64>(sizeof(Length)) > NameBlobOffset)
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Length, Data + Cursor, sizeof(Length));
+		Cursor += sizeof(Length);
+
+		if (Cursor + Length > NameBlobOffset)
+		{
+			return false;
+		}
+		FUTF8ToTCHAR PartString(reinterpret_cast<const ANSICHAR*>(Data + Cursor), Length);
+		PartIds.Add(FPrimaryAssetId(FString(PartString.Length(), PartString.Get())));
+		Cursor += Length;
+	}
+
+	NameBlob = reinterpret_cast<const ANSICHAR*>(Data + NameBlobOffset);
+	NameBlobSize = Header.NameBlobSize;
+	BuildRecords = reinterpret_cast<const FMechLoadoutBuildRecord*>(Data + BuildsOffset);
+	NumBuildRecords = Header.NumBuilds;
+	return true;
+}
+
+FString FMechLoadoutArchiveReader::GetBuildName(int32 Index) const
+{
+	if (Index < 0 || Index >= NumBuilds())
+	{
+		return FString();
+	}
+
+	const uint32 NameOffset = BuildRecords[Index].NameOffset;
+	if (NameOffset >= NameBlobSize)
+	{
+		return FString();
+	}
+
+	const ANSICHAR* Name = NameBlob + NameOffset;
+	const int32 Length = FCStringAnsi::Strnlen(Name, NameBlobSize - NameOffset);
+	FUTF8ToTCHAR NameString(Name, Length);
+	return FString(NameString.Length(), NameString.Get());
+}
+
+bool FMechLoadoutArchiveReader::ReadBuild(int32 Index, FMechSavedBuild& OutBuild) const
+{
+	if (Index < 0 || Index >= NumBuilds())
+	{
+		return false;
+	}
+
+	const FMechLoadoutBuildRecord& Record = BuildRecords[Index];
+	OutBuild.Name = GetBuildName(Index);
+	for (int32 SlotIndex = 0; SlotIndex < NumMechPartSlots; ++SlotIndex)
+	{
+		const uint16 PartIndex = Record.PartIndices[SlotIndex];
+		OutBuild.Parts[SlotIndex] = PartIds.IsValidIndex(PartIndex) ? PartIds[PartIndex] : FPrimaryAssetId();
+	}
+	return true;
+}
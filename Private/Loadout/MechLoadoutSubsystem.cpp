@@ -0,0 +1,230 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Loadout/MechLoadoutSubsystem.h"
+#include "Data/MechTuningData.h"
+#include "Engine/AssetManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "../../ProjectMC.h"
+
+void UMechLoadoutSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Mapping only touches the header and part table; a missing file just means no saved builds
+	SavedBuilds.Open(GetSavedBuildsFilename());
+}
+
+void UMechLoadoutSubsystem::Deinitialize()
+{
+	for (const TWeakObjectPtr<UMechTuningData>& WatchedBase : WatchedBases)
+	{
+		if (UMechTuningData* Base = WatchedBase.Get())
+		{
+			Base->OnTuningChanged.RemoveAll(this);
+		}
+	}
+	WatchedBases.Empty();
+	DerivedTuningLookup.Empty();
+	DerivedTunings.Empty();
+	SavedBuilds.Close();
+
+	Super::Deinitialize();
+}
+
+FString UMechLoadoutSubsystem::GetSavedBuildsFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Loadouts") / TEXT("Builds.mcld");
+}
+
+FMechLoadoutTuningKey UMechLoadoutSubsystem::MakeKey(const FMechLoadout& Loadout, const UMechTuningData* Base)
+{
+	FMechLoadoutTuningKey Key;
+	Key.Base = Base;
+	for (int32 SlotIndex = 0; SlotIndex < NumMechPartSlots; ++SlotIndex)
+	{
+		Key.Parts[SlotIndex] = Loadout.Parts[SlotIndex];
+	}
+	return Key;
+}
+
+UMechTuningData* UMechLoadoutSubsystem::GetTuningForLoadout(const FMechLoadout& Loadout, UMechTuningData* Base)
+{
+	if (!Base)
+	{
+		return nullptr;
+	}
+
+	const FMechLoadoutTuningKey Key = MakeKey(Loadout, Base);
+	if (const int32* ExistingIndex = DerivedTuningLookup.Find(Key))
+	{
+		if (UMechTuningData* ExistingTuning = DerivedTunings[*ExistingIndex].Tuning.Get())
+		{
+			return ExistingTuning;
+		}
+	}
+
+	// Only new builds pay for pruning; lookups of equipped builds stay a single map find
+	PruneDerivedTunings();
+
+	// The base is the template, so every authored value starts out copied
+	UMechTuningData* Tuning = NewObject<UMechTuningData>(this, NAME_None, RF_NoFlags, Base);
+	Tuning->LoadoutBase = Base;
+	Loadout.ApplyToTuning(*Base, *Tuning);
+	Tuning->NotifyTuningChanged();
+
+	FMechDerivedTuning& Entry = DerivedTunings.AddDefaulted_GetRef();
+	Entry.Loadout = Loadout;
+	Entry.Tuning = Tuning;
+	DerivedTuningLookup.Add(Key, DerivedTunings.Num() - 1);
+
+	if (!WatchedBases.Contains(Base))
+	{
+		WatchedBases.Add(Base);
+		Base->OnTuningChanged.AddUObject(this, &UMechLoadoutSubsystem::HandleBaseTuningChanged);
+	}
+
+	return Tuning;
+}
+
+void UMechLoadoutSubsystem::PatchTuning(const UMechTuningData& Base, const FMechLoadout& Loadout, UMechTuningData& Derived)
+{
+	// Transient properties are the derived values and LoadoutBase, which belong to Derived;
+	// loadout-driven values are rewritten by ApplyToTuning below
+	for (TFieldIterator<FProperty> It(UMechTuningData::StaticClass()); It; ++It)
+	{
+		if (!It->HasAnyPropertyFlags(CPF_Transient) && !FMechLoadout::IsLoadoutDriven(**It) && !It->Identical_InContainer(&Derived, &Base))
+		{
+			It->CopyCompleteValue_InContainer(&Derived, &Base);
+		}
+	}
+
+	Loadout.ApplyToTuning(Base, Derived);
+
+	// Recomputes the derived values and pushes the result to mechs already using this tuning
+	Derived.NotifyTuningChanged();
+}
+
+void UMechLoadoutSubsystem::HandleBaseTuningChanged(const UMechTuningData* Base)
+{
+	for (const FMechDerivedTuning& Entry : DerivedTunings)
+	{
+		UMechTuningData* Tuning = Entry.Tuning.Get();
+		if (Tuning && Tuning->LoadoutBase == Base)
+		{
+			PatchTuning(*Base, Entry.Loadout, *Tuning);
+		}
+	}
+}
+
+void UMechLoadoutSubsystem::PruneDerivedTunings()
+{
+	const int32 NumRemoved = DerivedTunings.RemoveAll([](const FMechDerivedTuning& Entry)
+	{
+		return !Entry.Tuning.IsValid();
+	});
+	if (NumRemoved == 0)
+	{
+		return;
+	}
+
+	TSet<TWeakObjectPtr<UMechTuningData>> LiveBases;
+	DerivedTuningLookup.Reset();
+	for (int32 Index = 0; Index < DerivedTunings.Num(); ++Index)
+	{
+		UMechTuningData* Base = DerivedTunings[Index].Tuning->LoadoutBase;
+		DerivedTuningLookup.Add(MakeKey(DerivedTunings[Index].Loadout, Base), Index);
+		LiveBases.Add(Base);
+	}
+
+	for (const TWeakObjectPtr<UMechTuningData>& WatchedBase : WatchedBases)
+	{
+		UMechTuningData* Base = WatchedBase.Get();
+		if (Base && !LiveBases.Contains(WatchedBase))
+		{
+			Base->OnTuningChanged.RemoveAll(this);
+		}
+	}
+	WatchedBases = MoveTemp(LiveBases);
+}
+
+bool UMechLoadoutSubsystem::SaveBuilds(const TArray<FMechLoadout>& Builds)
+{
+	TArray<FMechSavedBuild> SavedBuildRecords;
+	SavedBuildRecords.Reserve(Builds.Num());
+	for (const FMechLoadout& Build : Builds)
+	{
+		FMechSavedBuild& Record = SavedBuildRecords.AddDefaulted_GetRef();
+		Record.Name = Build.BuildName;
+		for (int32 SlotIndex = 0; SlotIndex < NumMechPartSlots; ++SlotIndex)
+		{
+			if (const UMechPartData* Part = Build.Parts[SlotIndex])
+			{
+				Record.Parts[SlotIndex] = Part->GetPrimaryAssetId();
+			}
+		}
+	}
+
+	// Write beside the old file and swap it in afterwards, so a failed or interrupted save leaves
+	// the old builds intact and mapped
+	const FString Filename = GetSavedBuildsFilename();
+	const FString TempFilename = Filename + TEXT(".tmp");
+	bool bSaved = MechLoadoutArchive::Save(TempFilename, SavedBuildRecords);
+	if (bSaved)
+	{
+		// Some platforms can't replace a file that is still mapped; a failed move reopens the old one
+		SavedBuilds.Close();
+		bSaved = IFileManager::Get().Move(*Filename, *TempFilename, true, true);
+		SavedBuilds.Open(Filename);
+	}
+
+	if (!bSaved)
+	{
+		IFileManager::Get().Delete(*TempFilename, false, false, true);
+		UE_LOG(LogProjectMC, Error, TEXT("Failed to save %d loadouts to %s"), Builds.Num(), *Filename);
+	}
+	return bSaved;
+}
+
+int32 UMechLoadoutSubsystem::GetNumSavedBuilds() const
+{
+	return SavedBuilds.NumBuilds();
+}
+
+FString UMechLoadoutSubsystem::GetSavedBuildName(int32 Index) const
+{
+	return SavedBuilds.GetBuildName(Index);
+}
+
+bool UMechLoadoutSubsystem::LoadSavedBuild(int32 Index, FMechLoadout& OutLoadout) const
+{
+	FMechSavedBuild Record;
+	if (!SavedBuilds.ReadBuild(Index, Record))
+	{
+		return false;
+	}
+
+	OutLoadout = FMechLoadout();
+	OutLoadout.BuildName = Record.Name;
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	for (const FPrimaryAssetId& PartId : Record.Parts)
+	{
+		if (!PartId.IsValid())
+		{
+			continue;
+		}
+
+		UMechPartData* Part = Cast<UMechPartData>(AssetManager.GetPrimaryAssetPath(PartId).TryLoad());
+		if (Part)
+		{
+			OutLoadout.SetPart(Part);
+		}
+		else
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("Saved build '%s' references missing part %s"), *Record.Name, *PartId.ToString());
+		}
+	}
+	return true;
+}
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Loadout/MechPartData.h"
+
+const FPrimaryAssetType UMechPartData::PrimaryAssetType = TEXT("MechPart");
+
+FMechPartStats& FMechPartStats::operator+=(const FMechPartStats& Other)
+{
+	Weight += Other.Weight;
+	LoadCapacity += Other.LoadCapacity;
+	EnergyCapacity += Other.EnergyCapacity;
+	EnergyOutput += Other.EnergyOutput;
+	EnergyDrain += Other.EnergyDrain;
+	BoostThrust += Other.BoostThrust;
+	BoostConsumption += Other.BoostConsumption;
+	JumpThrust += Other.JumpThrust;
+	DashThrust += Other.DashThrust;
+	return *this;
+}
+
+FMechPartStats& FMechPartStats::operator-=(const FMechPartStats& Other)
+{
+	Weight -= Other.Weight;
+	LoadCapacity -= Other.LoadCapacity;
+	EnergyCapacity -= Other.EnergyCapacity;
+	EnergyOutput -= Other.EnergyOutput;
+	EnergyDrain -= Other.EnergyDrain;
+	BoostThrust -= Other.BoostThrust;
+	BoostConsumption -= Other.BoostConsumption;
+	JumpThrust -= Other.JumpThrust;
+	DashThrust -= Other.DashThrust;
+	return *this;
+}
+
+FPrimaryAssetId UMechPartData::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
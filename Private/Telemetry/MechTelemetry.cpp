@@ -0,0 +1,487 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Telemetry/MechTelemetry.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "../../ProjectMC.h"
+#include <atomic>
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Telemetry files are written in native byte order and assume little endian");
+
+namespace MechTelemetry
+{
+	/** Bytes one record takes across all columns of a block */
+	constexpr int32 ColumnBytesPerRecord = sizeof(double) + sizeof(uint32) + 3 * sizeof(float) + 2 * sizeof(uint8);
+
+	/** Records buffered before the writer compresses a block */
+	constexpr int32 RecordsPerBlock = 16384;
+
+	/** A partial block is still written after this long, so a crash loses little */
+	constexpr double MaxSecondsPerBlock = 5.0;
+
+	constexpr uint32 DrainIntervalMs = 50;
+
+	/**
+	 * Wakes the writer early when a ring fills up faster than DrainIntervalMs drains it. Created with
+	 * the first session and never freed, so producers can trigger it without racing StopSession.
+	 */
+	static std::atomic<FEvent*> WriterWakeEvent{nullptr};
+
+	/**
+	 * Single-producer, single-consumer ring. Only the owning thread pushes and only the writer
+	 * thread drains, so head and tail each have one writer and no locks are needed.
+	 */
+	class FRing
+	{
+	public:
+		static constexpr uint64 Capacity = 4096;
+
+		bool Push(const FMechTelemetryRecord& InRecord)
+		{
+			const uint64 CurrentHead = Head.load(std::memory_order_relaxed);
+			if (CurrentHead - Tail.load(std::memory_order_acquire) >= Capacity)
+			{
+				Dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			Records[CurrentHead & (Capacity - 1)] = InRecord;
+			Head.store(CurrentHead + 1, std::memory_order_release);
+
+			// Only the push that crosses half full pays for the trigger
+			if (CurrentHead + 1 - Tail.load(std::memory_order_relaxed) == Capacity / 2)
+			{
+				if (FEvent* WakeEvent = WriterWakeEvent.load(std::memory_order_acquire))
+				{
+					WakeEvent->Trigger();
+				}
+			}
+			return true;
+		}
+
+		template <typename FuncType>
+		void Drain(FuncType&& Visit)
+		{
+			const uint64 CurrentTail = Tail.load(std::memory_order_relaxed);
+			const uint64 CurrentHead = Head.load(std::memory_order_acquire);
+			for (uint64 Index = CurrentTail; Index < CurrentHead; ++Index)
+			{
+				Visit(Records[Index & (Capacity - 1)]);
+			}
+			Tail.store(CurrentHead, std::memory_order_release);
+		}
+
+		bool IsEmpty() const
+		{
+			return Head.load(std::memory_order_acquire) == Tail.load(std::memory_order_acquire);
+		}
+
+		uint32 TakeDropped()
+		{
+			return Dropped.exchange(0, std::memory_order_relaxed);
+		}
+
+	private:
+		static_assert(FMath::IsPowerOfTwo(Capacity), "Ring capacity must be a power of two");
+
+		FMechTelemetryRecord Records[Capacity];
+
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Head{0};
+
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Tail{0};
+
+		std::atomic<uint32> Dropped{0};
+	};
+
+	/** Every ring ever created; rings outlive their threads so the writer never sees a dangling one */
+	static FCriticalSection RingsLock;
+	static TArray<TUniquePtr<FRing>> Rings;
+	static thread_local FRing* ThreadRing = nullptr;
+
+	static std::atomic<bool> bSessionActive{false};
+
+	static FRing& GetThreadRing()
+	{
+		// Registration takes the lock once per thread; every push after that is lock-free
+		if (!ThreadRing)
+		{
+			FScopeLock Lock(&RingsLock);
+			ThreadRing = Rings.Add_GetRef(MakeUnique<FRing>()).Get();
+		}
+		return *ThreadRing;
+	}
+
+	/** Drains the rings into column buffers and appends a compressed block when enough has built up */
+	class FWriter : public FRunnable
+	{
+	public:
+		FWriter(IFileHandle* InFile, FEvent* InWakeEvent)
+			: File(InFile)
+			, WakeEvent(InWakeEvent)
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			LastBlockTime = FPlatformTime::Seconds();
+			while (!bStopping.load(std::memory_order_acquire))
+			{
+				WakeEvent->Wait(DrainIntervalMs);
+				DrainRings();
+
+				if (Time.Num() >= RecordsPerBlock || FPlatformTime::Seconds() - LastBlockTime >= MaxSecondsPerBlock)
+				{
+					WriteBlock();
+				}
+			}
+
+			DrainRings();
+			WriteBlock();
+			File->Flush();
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping.store(true, std::memory_order_release);
+			WakeEvent->Trigger();
+		}
+
+	private:
+		void DrainRings()
+		{
+			{
+				FScopeLock Lock(&RingsLock);
+				RingSnapshot.Reset(Rings.Num());
+				for (const TUniquePtr<FRing>& Ring : Rings)
+				{
+					RingSnapshot.Add(Ring.Get());
+				}
+			}
+
+			for (FRing* Ring : RingSnapshot)
+			{
+				NumDropped += Ring->TakeDropped();
+				Ring->Drain([this](const FMechTelemetryRecord& InRecord)
+				{
+					Time.Add(InRecord.Time);
+					MechId.Add(InRecord.MechId);
+					EnergyBefore.Add(InRecord.EnergyBefore);
+					EnergyAfter.Add(InRecord.EnergyAfter);
+					Speed.Add(InRecord.Speed);
+					Event.Add(static_cast<uint8>(InRecord.Event));
+					DashType.Add(static_cast<uint8>(InRecord.DashType));
+				});
+			}
+		}
+
+		template <typename ElementType>
+		void AppendColumn(TArray<ElementType>& Column)
+		{
+			Uncompressed.Append(reinterpret_cast<const uint8*>(Column.GetData()), Column.Num() * sizeof(ElementType));
+			Column.Reset();
+		}
+
+		void WriteBlock()
+		{
+			LastBlockTime = FPlatformTime::Seconds();
+
+			const int32 NumRecords = Time.Num();
+			if (NumRecords == 0 && NumDropped == 0)
+			{
+				return;
+			}
+
+			// Column-major: similar values sit together, which compresses far better than whole records
+			Uncompressed.Reset(NumRecords * ColumnBytesPerRecord);
+			AppendColumn(Time);
+			AppendColumn(MechId);
+			AppendColumn(EnergyBefore);
+			AppendColumn(EnergyAfter);
+			AppendColumn(Speed);
+			AppendColumn(Event);
+			AppendColumn(DashType);
+
+			int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Uncompressed.Num());
+			Compressed.SetNumUninitialized(CompressedSize);
+			if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Uncompressed.GetData(), Uncompressed.Num()))
+			{
+				UE_LOG(LogProjectMC, Warning, TEXT("Failed to compress a block of %d telemetry events; dropping it"), NumRecords);
+				NumDropped += NumRecords;
+				return;
+			}
+
+			FMechTelemetryBlockHeader BlockHeader;
+			BlockHeader.NumRecords = NumRecords;
+			BlockHeader.UncompressedSize = Uncompressed.Num();
+			BlockHeader.CompressedSize = CompressedSize;
+			BlockHeader.NumDropped = NumDropped;
+			NumDropped = 0;
+
+			File->Write(reinterpret_cast<const uint8*>(&BlockHeader), sizeof(BlockHeader));
+			File->Write(Compressed.GetData(), CompressedSize);
+		}
+
+		TUniquePtr<IFileHandle> File;
+
+		FEvent* WakeEvent;
+
+		std::atomic<bool> bStopping{false};
+
+		double LastBlockTime = 0.0;
+
+		uint32 NumDropped = 0;
+
+		TArray<FRing*> RingSnapshot;
+
+		TArray<double> Time;
+		TArray<uint32> MechId;
+		TArray<float> EnergyBefore;
+		TArray<float> EnergyAfter;
+		TArray<float> Speed;
+		TArray<uint8> Event;
+		TArray<uint8> DashType;
+
+		TArray<uint8> Uncompressed;
+		TArray<uint8> Compressed;
+	};
+
+	/** Session state; only touched from the game thread */
+	static TUniquePtr<FWriter> Writer;
+	static TUniquePtr<FRunnableThread> WriterThread;
+
+	bool IsActive()
+	{
+		return bSessionActive.load(std::memory_order_relaxed);
+	}
+
+	void Record(const FMechTelemetryRecord& InRecord)
+	{
+		if (IsActive())
+		{
+			GetThreadRing().Push(InRecord);
+		}
+	}
+
+	bool StartSession(const FString& Filename)
+	{
+		check(IsInGameThread());
+
+		if (Writer)
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("A telemetry session is already running; not starting %s"), *Filename);
+			return false;
+		}
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+		IFileHandle* File = PlatformFile.OpenWrite(*Filename);
+		if (!File)
+		{
+			UE_LOG(LogProjectMC, Error, TEXT("Could not open %s for telemetry"), *Filename);
+			return false;
+		}
+
+		FMechTelemetryFileHeader Header;
+		Header.Magic = FileMagic;
+		Header.Version = CurrentVersion;
+		Header.Reserved = 0;
+		File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+		// Leftovers from a previous session were recorded after it stopped; don't attribute them to this one
+		{
+			FScopeLock Lock(&RingsLock);
+			for (const TUniquePtr<FRing>& Ring : Rings)
+			{
+				Ring->Drain([](const FMechTelemetryRecord&) {});
+				Ring->TakeDropped();
+			}
+		}
+
+		FEvent* WakeEvent = WriterWakeEvent.load(std::memory_order_relaxed);
+		if (!WakeEvent)
+		{
+			WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+			WriterWakeEvent.store(WakeEvent, std::memory_order_release);
+		}
+
+		Writer = MakeUnique<FWriter>(File, WakeEvent);
+		WriterThread.Reset(FRunnableThread::Create(Writer.Get(), TEXT("MechTelemetryWriter"), 0, TPri_BelowNormal));
+		if (!WriterThread)
+		{
+			UE_LOG(LogProjectMC, Error, TEXT("Telemetry needs a writer thread, which this platform didn't provide"));
+			Writer.Reset();
+			return false;
+		}
+
+		bSessionActive.store(true, std::memory_order_release);
+
+		UE_LOG(LogProjectMC, Log, TEXT("Recording mech telemetry to %s"), *Filename);
+		return true;
+	}
+
+	void StopSession()
+	{
+		check(IsInGameThread());
+
+		if (!Writer)
+		{
+			return;
+		}
+
+		bSessionActive.store(false, std::memory_order_release);
+
+		// Kill stops the writer, which drains the rings one last time before closing the file
+		WriterThread->Kill(true);
+		WriterThread.Reset();
+		Writer.Reset();
+	}
+
+	FString GetDefaultSessionFilename()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Telemetry") / FString::Printf(TEXT("Mech-%s.mctl"), *FDateTime::Now().ToString());
+	}
+}
+
+bool FMechTelemetryFileReader::Open(const FString& Filename)
+{
+	Cursor = 0;
+	if (!FFileHelper::LoadFileToArray(FileData, *Filename, FILEREAD_Silent) || FileData.Num() < static_cast<int32>(sizeof(FMechTelemetryFileHeader)))
+	{
+		return false;
+	}
+
+	FMechTelemetryFileHeader Header;
+	FMemory::Memcpy(&Header, FileData.GetData(), sizeof(Header));
+	if (Header.Magic != MechTelemetry::FileMagic || Header.Version != MechTelemetry::CurrentVersion)
+	{
+		UE_LOG(LogProjectMC, Warning, TEXT("%s is not a version %d telemetry file"), *Filename, MechTelemetry::CurrentVersion);
+		return false;
+	}
+
+	Cursor = sizeof(Header);
+	return true;
+}
+
+bool FMechTelemetryFileReader::ReadNextBlock(FMechTelemetryBlock& OutBlock)
+{
+	if (Cursor + static_cast<int64>(sizeof(FMechTelemetryBlockHeader)) > FileData.Num())
+	{
+		return false;
+	}
+
+	FMechTelemetryBlockHeader BlockHeader;
+	FMemory::Memcpy(&BlockHeader, FileData.GetData() + Cursor, sizeof(BlockHeader));
+	Cursor += sizeof(BlockHeader);
+
+	// A block cut short by a crash ends the file rather than failing it
+	if (Cursor + BlockHeader.CompressedSize > FileData.Num()
+		|| BlockHeader.UncompressedSize != BlockHeader.NumRecords * static_cast<uint32>(MechTelemetry::ColumnBytesPerRecord))
+	{
+		return false;
+	}
+
+	BlockData.SetNumUninitialized(BlockHeader.UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, BlockData.GetData(), BlockData.Num(), FileData.GetData() + Cursor, BlockHeader.CompressedSize))
+	{
+		return false;
+	}
+	Cursor += BlockHeader.CompressedSize;
+
+	const int32 NumRecords = BlockHeader.NumRecords;
+	const uint8* Column = BlockData.GetData();
+	OutBlock.NumRecords = NumRecords;
+	OutBlock.NumDropped = BlockHeader.NumDropped;
+	OutBlock.Time = reinterpret_cast<const double*>(Column);
+	Column += NumRecords * sizeof(double);
+	OutBlock.MechId = reinterpret_cast<const uint32*>(Column);
+	Column += NumRecords * sizeof(uint32);
+	OutBlock.EnergyBefore = reinterpret_cast<const float*>(Column);
+	Column += NumRecords * sizeof(float);
+	OutBlock.EnergyAfter = reinterpret_cast<const float*>(Column);
+	Column += NumRecords * sizeof(float);
+	OutBlock.Speed = reinterpret_cast<const float*>(Column);
+	Column += NumRecords * sizeof(float);
+	OutBlock.Event = reinterpret_cast<const EMechTelemetryEvent*>(Column);
+	Column += NumRecords;
+	OutBlock.DashType = reinterpret_cast<const EMechDashType*>(Column);
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand CmdMechTelemetryStart(
+	TEXT("mc.Telemetry.Start"),
+	TEXT("Starts recording mech telemetry. Usage: mc.Telemetry.Start [Filename]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		MechTelemetry::StartSession(Args.Num() > 0 ? Args[0] : MechTelemetry::GetDefaultSessionFilename());
+	}));
+
+static FAutoConsoleCommand CmdMechTelemetryStop(
+	TEXT("mc.Telemetry.Stop"),
+	TEXT("Stops recording mech telemetry and closes the file"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		MechTelemetry::StopSession();
+	}));
+
+static FAutoConsoleCommand CmdMechTelemetryBench(
+	TEXT("mc.Telemetry.Bench"),
+	TEXT("Records synthetic events from the game thread and logs the cost per event. They are written with MechId 0. Usage: mc.Telemetry.Bench [NumEvents]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (!MechTelemetry::IsActive())
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("mc.Telemetry.Bench needs a running session (mc.Telemetry.Start)"));
+			return;
+		}
+
+		const int32 NumEvents = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000000;
+
+		// Push in bursts that fit the ring and let the writer catch up between them, so the
+		// timing covers the push itself rather than the full-ring drop path
+		constexpr int32 BurstSize = MechTelemetry::FRing::Capacity / 2;
+		MechTelemetry::FRing& Ring = MechTelemetry::GetThreadRing();
+
+		FMechTelemetryRecord BenchRecord;
+		BenchRecord.Event = EMechTelemetryEvent::Dash;
+		BenchRecord.DashType = EMechDashType::Forward;
+
+		uint64 PushCycles = 0;
+		int32 NumDropped = 0;
+		for (int32 NumPushed = 0; NumPushed < NumEvents;)
+		{
+			const int32 Burst = FMath::Min(BurstSize, NumEvents - NumPushed);
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Index = 0; Index < Burst; ++Index)
+			{
+				// Same work as MechTelemetry::Record, but counting drops
+				BenchRecord.Time = NumPushed + Index;
+				if (MechTelemetry::IsActive() && !MechTelemetry::GetThreadRing().Push(BenchRecord))
+				{
+					++NumDropped;
+				}
+			}
+			PushCycles += FPlatformTime::Cycles64() - StartCycles;
+			NumPushed += Burst;
+
+			const double WaitUntil = FPlatformTime::Seconds() + 1.0;
+			while (!Ring.IsEmpty() && FPlatformTime::Seconds() < WaitUntil)
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+		}
+
+		const double Nanoseconds = FPlatformTime::ToSeconds64(PushCycles) * 1e9;
+		UE_LOG(LogProjectMC, Log, TEXT("mc.Telemetry.Bench: %d events, %.1f ns per event, %d dropped"),
+			NumEvents, Nanoseconds / NumEvents, NumDropped);
+	}));
+#endif
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Telemetry/MechTelemetryQueryCommandlet.h"
+#include "Telemetry/MechTelemetry.h"
+#include "HAL/FileManager.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "../../ProjectMC.h"
+
+UMechTelemetryQueryCommandlet::UMechTelemetryQueryCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMechTelemetryQueryCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Files;
+	FString File;
+	if (FParse::Value(*Params, TEXT("File="), File))
+	{
+		Files.Add(File);
+	}
+	else
+	{
+		const FString TelemetryDir = FPaths::ProjectSavedDir() / TEXT("Telemetry");
+		IFileManager::Get().FindFiles(Files, *(TelemetryDir / TEXT("*.mctl")), true, false);
+		for (FString& Filename : Files)
+		{
+			Filename = TelemetryDir / Filename;
+		}
+	}
+
+	// Mechs can be given by the name or net id they were recorded under, or by the id itself
+	FString MechParam;
+	const bool bFilterMech = FParse::Value(*Params, TEXT("Mech="), MechParam);
+	const uint32 MechFilter = MechParam.IsNumeric() ? static_cast<uint32>(FCString::Strtoui64(*MechParam, nullptr, 10)) : MechTelemetry::MakeMechId(MechParam);
+
+	struct FDashSummary
+	{
+		int64 Count = 0;
+		double EnergySpent = 0.0;
+		double Speed = 0.0;
+	};
+
+	int64 EventCounts[static_cast<int32>(EMechTelemetryEvent::Count)] = {};
+	FDashSummary DashSummaries[static_cast<int32>(EMechDashType::Count)];
+	TMap<uint32, double> LastJumpTime;
+	double JumpIntervalSum = 0.0;
+	int64 NumJumpIntervals = 0;
+	int64 NumRecords = 0;
+	int64 NumDropped = 0;
+
+	for (const FString& Filename : Files)
+	{
+		FMechTelemetryFileReader Reader;
+		if (!Reader.Open(Filename))
+		{
+			UE_LOG(LogProjectMC, Warning, TEXT("Skipping %s"), *Filename);
+			continue;
+		}
+
+		// Jump intervals don't carry across sessions
+		LastJumpTime.Reset();
+
+		FMechTelemetryBlock Block;
+		while (Reader.ReadNextBlock(Block))
+		{
+			NumDropped += Block.NumDropped;
+			for (int32 Index = 0; Index < Block.NumRecords; ++Index)
+			{
+				if (bFilterMech && Block.MechId[Index] != MechFilter)
+				{
+					continue;
+				}
+
+				const EMechTelemetryEvent Event = Block.Event[Index];
+				if (Event >= EMechTelemetryEvent::Count)
+				{
+					continue;
+				}
+
+				++NumRecords;
+				++EventCounts[static_cast<int32>(Event)];
+
+				if (Event == EMechTelemetryEvent::Dash && Block.DashType[Index] < EMechDashType::Count)
+				{
+					FDashSummary& Summary = DashSummaries[static_cast<int32>(Block.DashType[Index])];
+					++Summary.Count;
+					Summary.EnergySpent += Block.EnergyBefore[Index] - Block.EnergyAfter[Index];
+					Summary.Speed += Block.Speed[Index];
+				}
+				else if (Event == EMechTelemetryEvent::Jump)
+				{
+					double& LastTime = LastJumpTime.FindOrAdd(Block.MechId[Index], -1.0);
+					if (LastTime >= 0.0)
+					{
+						JumpIntervalSum += Block.Time[Index] - LastTime;
+						++NumJumpIntervals;
+					}
+					LastTime = Block.Time[Index];
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogProjectMC, Display, TEXT("%lld events from %d files (%lld dropped at record time)"), NumRecords, Files.Num(), NumDropped);
+
+	const UEnum* EventEnum = StaticEnum<EMechTelemetryEvent>();
+	for (int32 EventIndex = 0; EventIndex < static_cast<int32>(EMechTelemetryEvent::Count); ++EventIndex)
+	{
+		UE_LOG(LogProjectMC, Display, TEXT("  %-14s %lld"), *EventEnum->GetNameStringByValue(EventIndex), EventCounts[EventIndex]);
+	}
+
+	const UEnum* DashTypeEnum = StaticEnum<EMechDashType>();
+	for (int32 DashTypeIndex = 0; DashTypeIndex < static_cast<int32>(EMechDashType::Count); ++DashTypeIndex)
+	{
+		const FDashSummary& Summary = DashSummaries[DashTypeIndex];
+		if (Summary.Count > 0)
+		{
+			UE_LOG(LogProjectMC, Display, TEXT("  Dash %-12s %lld, avg energy spent %.2f, avg speed %.0f"),
+				*DashTypeEnum->GetNameStringByValue(DashTypeIndex), Summary.Count, Summary.EnergySpent / Summary.Count, Summary.Speed / Summary.Count);
+		}
+	}
+
+	// Turn dashes only rotate the view and never reach the velocity limit
+	const int64 NumLimitableDashes = EventCounts[static_cast<int32>(EMechTelemetryEvent::Dash)] - DashSummaries[static_cast<int32>(EMechDashType::Turn)].Count;
+	if (NumLimitableDashes > 0)
+	{
+		UE_LOG(LogProjectMC, Display, TEXT("  Dashes hitting the velocity limit: %.1f%%"),
+			100.0 * EventCounts[static_cast<int32>(EMechTelemetryEvent::DashClamped)] / NumLimitableDashes);
+	}
+
+	if (NumJumpIntervals > 0)
+	{
+		UE_LOG(LogProjectMC, Display, TEXT("  Average time between jumps: %.2fs"), JumpIntervalSum / NumJumpIntervals);
+	}
+
+	return 0;
+}
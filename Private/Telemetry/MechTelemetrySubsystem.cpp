@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Telemetry/MechTelemetrySubsystem.h"
+#include "Telemetry/MechTelemetry.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+static TAutoConsoleVariable<bool> CVarMechTelemetry(
+	TEXT("mc.Telemetry"),
+	false,
+	TEXT("When enabled, each game instance records a telemetry session to Saved/Telemetry. -MechTelemetry on the command line does the same."));
+
+void UMechTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (CVarMechTelemetry.GetValueOnGameThread() || FParse::Param(FCommandLine::Get(), TEXT("MechTelemetry")))
+	{
+		bOwnsSession = MechTelemetry::StartSession(MechTelemetry::GetDefaultSessionFilename());
+	}
+}
+
+void UMechTelemetrySubsystem::Deinitialize()
+{
+	// Sessions started by hand with mc.Telemetry.Start are left to mc.Telemetry.Stop
+	if (bOwnsSession)
+	{
+		MechTelemetry::StopSession();
+		bOwnsSession = false;
+	}
+
+	Super::Deinitialize();
+}
@@ -3,5 +3,6 @@
 #include "ProjectMC.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogProjectMC);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ProjectMC, "ProjectMC" );
- 
\ No newline at end of file
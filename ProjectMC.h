@@ -3,3 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogProjectMC, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("ProjectMC"), STATGROUP_ProjectMC, STATCAT_Advanced);
@@ -4,6 +4,7 @@
 #include "Engine/LocalPlayer.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/Controller.h"
@@ -16,7 +17,8 @@ DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 //////////////////////////////////////////////////////////////////////////
 // AProjectMCCharacter
 
-AProjectMCCharacter::AProjectMCCharacter()
+AProjectMCCharacter::AProjectMCCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
@@ -39,16 +41,31 @@ AProjectMCCharacter::AProjectMCCharacter()
 	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
 	GetCharacterMovement()->BrakingDecelerationFalling = 1500.0f;
 
+	// Cameras are optional so server-only subclasses can skip them with DoNotCreateDefaultSubobject;
+	// dedicated servers that still have them switch them off in TrimForDedicatedServer
 	// Create a camera boom (pulls in towards the player if there is a collision)
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-	CameraBoom->SetupAttachment(RootComponent);
-	CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
-	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+	CameraBoom = CreateOptionalDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	if (CameraBoom)
+	{
+		CameraBoom->SetupAttachment(RootComponent);
+		CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
+		CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+	}
 
 	// Create a follow camera
-	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
-	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
-	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	FollowCamera = CreateOptionalDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+	if (FollowCamera)
+	{
+		if (CameraBoom)
+		{
+			FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
+		}
+		else
+		{
+			FollowCamera->SetupAttachment(RootComponent);
+		}
+		FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	}
 
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
@@ -58,6 +75,33 @@ void AProjectMCCharacter::BeginPlay()
 {
 	// Call the base class  
 	Super::BeginPlay();
+
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		TrimForDedicatedServer();
+	}
+}
+
+void AProjectMCCharacter::TrimForDedicatedServer()
+{
+	if (CameraBoom)
+	{
+		CameraBoom->SetComponentTickEnabled(false);
+		CameraBoom->Deactivate();
+	}
+
+	if (FollowCamera)
+	{
+		FollowCamera->SetComponentTickEnabled(false);
+		FollowCamera->Deactivate();
+	}
+
+	// Opt-in: this freezes every bone the anim graph drives, so it is only safe when nothing on the
+	// server reads bones or sockets
+	if (bServerOnlyTicksMontages)
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -29,7 +29,7 @@ class AProjectMCCharacter : public ACharacter
 	UCameraComponent* FollowCamera;
 	
 public:
-	AProjectMCCharacter();
+	AProjectMCCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	
 
 protected:
@@ -46,6 +46,9 @@ protected:
 	// To add mapping context
 	virtual void BeginPlay();
 
+	/** Disables cosmetic and camera work that a dedicated server never needs */
+	virtual void TrimForDedicatedServer();
+
 protected:
 	/** MappingContext */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
@@ -62,10 +65,17 @@ protected:
 	/** Look Input Action */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputAction* LookAction;
+
+	/**
+	 * On a dedicated server, tick only montages and skip the anim graph. Bones the graph drives then
+	 * stay frozen, so only enable this when nothing on the server reads bones or sockets.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = Server)
+	bool bServerOnlyTicksMontages = false;
 public:
-	/** Returns CameraBoom subobject **/
+	/** Returns CameraBoom subobject, null if a subclass skipped it **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
-	/** Returns FollowCamera subobject **/
+	/** Returns FollowCamera subobject, null if a subclass skipped it **/
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
 };
 
@@ -21,10 +21,12 @@ void AProjectMCGameMode::BeginPlay()
 {
 	Super::BeginPlay();
 	
+#if !UE_BUILD_SHIPPING && !UE_SERVER
 	// Debug message to show which pawn class is being used
-	if (DefaultPawnClass)
+	if (GEngine && DefaultPawnClass && !IsNetMode(NM_DedicatedServer))
 	{
 		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, 
 			FString::Printf(TEXT("Using Pawn Class: %s"), *DefaultPawnClass->GetName()));
 	}
+#endif
 }
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "MechAIController.generated.h"
+
+class AMechBoostJumpLink;
+class APlayerMech;
+class UNavigationQueryFilter;
+
+/**
+ * AI controller for APlayerMech bots. Paths are requested through UMechPathBatchSubsystem so
+ * they resolve asynchronously and are shared with squad mates heading the same way. The
+ * controller boosts on long legs and crosses AMechBoostJumpLink links, waiting for energy when
+ * it arrives short and routing around jumps it can never make.
+ */
+UCLASS()
+class PROJECTMC_API AMechAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AMechAIController();
+
+	/** Moves to Goal using a batched, possibly shared, path */
+	UFUNCTION(BlueprintCallable, Category = "Mech AI")
+	void MoveToLocationBatched(const FVector& Goal);
+
+	/** Called by a boost jump link when the mech reaches it */
+	void BeginBoostJump(AMechBoostJumpLink* Link, const FVector& Destination);
+
+	/** True from MoveToLocationBatched until the goal is reached or no path could be found */
+	bool HasMoveGoal() const { return bHasMoveGoal; }
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+
+	virtual void OnUnPossess() override;
+
+	virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+
+	/** Filter for the next path; skips boost jumps for mechs that can't refill energy to pay for them */
+	TSubclassOf<UNavigationQueryFilter> ChoosePathFilter() const;
+
+	void RequestBatchedPath(const FVector& Goal, TSubclassOf<UNavigationQueryFilter> FilterClass);
+
+	void HandlePathReady(FNavPathSharedPtr Path, FVector Goal, TSubclassOf<UNavigationQueryFilter> FilterClass);
+
+	/** Resumes the link and replans the current goal without boost jumps */
+	void AbandonBoostJump(AMechBoostJumpLink* Link);
+
+	/** Boosts along long path legs while energy stays above the reserve */
+	void UpdateBoost();
+
+	UFUNCTION()
+	void HandleLanded(const FHitResult& Hit);
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech AI")
+	float AcceptanceRadius = 150.f;
+
+	/** Remaining distance above which the bot boosts */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech AI")
+	float BoostDistanceThreshold = 2500.f;
+
+	/** Energy the bot keeps back for dashes instead of spending it on boosting */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech AI")
+	float BoostReserveEnergy = 30.f;
+
+	/** Times a failed path request is retried before the goal is dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech AI")
+	int32 MaxPathRetries = 3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech AI")
+	float PathRetryDelay = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech AI")
+	float BoostUpdateInterval = 0.25f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech AI")
+	TSubclassOf<UNavigationQueryFilter> NoBoostJumpFilterClass;
+
+private:
+	APlayerMech* GetMech() const;
+
+	FVector MoveGoal = FVector::ZeroVector;
+
+	bool bHasMoveGoal = false;
+
+	int32 NumPathRetries = 0;
+
+	TWeakObjectPtr<AMechBoostJumpLink> ActiveBoostJumpLink;
+
+	FTimerHandle BoostUpdateTimer;
+
+	FTimerHandle BoostJumpRetryTimer;
+
+	FTimerHandle PathRetryTimer;
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Navigation/NavLinkProxy.h"
+#include "MechBoostJumpLink.generated.h"
+
+class UMechTuningData;
+
+/**
+ * Smart nav link that mechs cross with a jump, boosting in the air when the gap is wider than a
+ * normal jump covers. The link's nav area is the energy tier of its jump for ReferenceTuning, so
+ * path costs grow with the energy a crossing spends. Bots without enough energy wait on the near
+ * side; bots that can never make the jump path around it.
+ */
+UCLASS()
+class PROJECTMC_API AMechBoostJumpLink : public ANavLinkProxy
+{
+	GENERATED_BODY()
+
+public:
+	AMechBoostJumpLink();
+
+	/**
+	 * Solves the jump from From to To for a mech with the given tuning. The flight is drag free:
+	 * the mech holds boost with no falling braking until it lands (see UMechMovementComponent::SetBoostJumping).
+	 * @return false if the target is too high, too far even at full boost, or needs more than a full tank
+	 */
+	static bool ComputeBoostJump(const UMechTuningData& Tuning, float GravityZ, const FVector& From, const FVector& To, FVector& OutLaunchVelocity, float& OutEnergyCost);
+
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+	/** Energy the jump costs for ReferenceTuning, in the more expensive direction */
+	float ComputeLinkEnergyCost() const;
+
+	UFUNCTION()
+	void HandleSmartLinkReached(AActor* MovingActor, const FVector& DestinationPoint);
+
+	/** Tuning the link's nav cost is computed for; the class defaults when unset */
+	UPROPERTY(EditAnywhere, Category = "Boost Jump")
+	UMechTuningData* ReferenceTuning = nullptr;
+
+	UPROPERTY(VisibleInstanceOnly, Category = "Boost Jump")
+	float EnergyCost = 0.f;
+};
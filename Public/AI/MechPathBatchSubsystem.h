@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationData.h"
+#include "MechPathBatchSubsystem.generated.h"
+
+class UNavigationQueryFilter;
+
+DECLARE_DELEGATE_OneParam(FOnMechPathReady, FNavPathSharedPtr);
+
+/** Quantized start/goal pair; requests that land in the same cells share one path query */
+struct FMechPathKey
+{
+	FIntVector StartCell;
+	FIntVector GoalCell;
+	const UClass* FilterClass = nullptr;
+
+	/** Non-zero for a query made for a single requester, which is never shared */
+	uint32 Exclusive = 0;
+
+	bool operator==(const FMechPathKey& Other) const
+	{
+		return StartCell == Other.StartCell && GoalCell == Other.GoalCell && FilterClass == Other.FilterClass && Exclusive == Other.Exclusive;
+	}
+
+	friend uint32 GetTypeHash(const FMechPathKey& Key)
+	{
+		return HashCombine(HashCombine(HashCombine(GetTypeHash(Key.StartCell), GetTypeHash(Key.GoalCell)), GetTypeHash(Key.FilterClass)), Key.Exclusive);
+	}
+};
+
+/**
+ * Batches path requests from mech AI. Identical requests in flight are coalesced, at most a
+ * budgeted number of async queries are dispatched per frame, and finished paths are cached so
+ * squad members starting near each other and heading to nearby goals reuse one result.
+ */
+UCLASS()
+class PROJECTMC_API UMechPathBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Queues a path request; OnReady fires with a path owned by the requester (null on failure) */
+	void RequestPath(const APawn* Requester, const FVector& Start, const FVector& Goal, TSubclassOf<UNavigationQueryFilter> FilterClass, FOnMechPathReady OnReady);
+
+	/** Drops every pending callback registered by Requester */
+	void CancelRequests(const APawn* Requester);
+
+	/** Logs query throughput and game-thread cost since the last reset */
+	void LogStats(bool bReset);
+
+private:
+	struct FPathWaiter
+	{
+		TWeakObjectPtr<const APawn> Requester;
+		FVector Start;
+		FVector Goal;
+		FOnMechPathReady OnReady;
+	};
+
+	struct FPendingPath
+	{
+		FVector Start;
+		FVector Goal;
+		TSubclassOf<UNavigationQueryFilter> FilterClass;
+		FNavAgentProperties AgentProperties;
+		TArray<FPathWaiter> Waiters;
+		uint32 QueryId = INVALID_NAVQUERYID;
+	};
+
+	struct FCachedPath
+	{
+		TArray<FNavPathPoint> PathPoints;
+		TWeakObjectPtr<const ANavigationData> NavData;
+		TSubclassOf<UNavigationQueryFilter> FilterClass;
+		bool bIsPartial = false;
+		double Timestamp = 0.0;
+	};
+
+	FMechPathKey MakeKey(const FVector& Start, const FVector& Goal, TSubclassOf<UNavigationQueryFilter> FilterClass) const;
+
+	/** Queues a new query for Key with Waiter as its first waiter */
+	void AddPendingPath(const FMechPathKey& Key, TSubclassOf<UNavigationQueryFilter> FilterClass, const FNavAgentProperties& AgentProperties, FPathWaiter&& Waiter);
+
+	void DispatchQuery(const FMechPathKey& Key, FPendingPath& PendingPath);
+
+	void HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, FMechPathKey Key);
+
+	/** Hands Waiter its copy of a shared path, or queues a query of its own when the path can't be adapted */
+	void DeliverSharedPath(const FCachedPath& CachedPath, FPathWaiter&& Waiter, const FNavAgentProperties& AgentProperties);
+
+	/**
+	 * Builds a private copy of a shared path that runs from the waiter's own start to its own goal.
+	 * Returns null when the new first or last leg isn't clear on the navmesh.
+	 */
+	FNavPathSharedPtr MakeWaiterPath(const FCachedPath& CachedPath, const FPathWaiter& Waiter) const;
+
+	/** Private copy of a path queried for one waiter, which already runs from its start to its goal */
+	static FNavPathSharedPtr CopyPath(const FCachedPath& CachedPath, const FPathWaiter& Waiter);
+
+	UFUNCTION()
+	void HandleNavigationGenerated(ANavigationData* NavData);
+
+	TMap<FMechPathKey, FPendingPath> PendingPaths;
+
+	/** Keys waiting for a dispatch slot, oldest first */
+	TArray<FMechPathKey> DispatchQueue;
+
+	TMap<FMechPathKey, FCachedPath> PathCache;
+
+	uint32 LastExclusiveKey = 0;
+
+	int64 NumRequests = 0;
+	int64 NumQueries = 0;
+	int64 NumCacheHits = 0;
+	int64 NumCoalesced = 0;
+	int64 NumRequeried = 0;
+	double GameThreadSeconds = 0.0;
+	double StatsStartTime = 0.0;
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavAreas/NavArea.h"
+#include "NavArea_MechBoostJump.generated.h"
+
+/**
+ * Area for links a mech crosses with a jump. Each subclass is an energy tier; a link uses the
+ * cheapest tier that covers its energy cost, and the tier's entering cost grows with that energy.
+ */
+UCLASS(Abstract)
+class PROJECTMC_API UNavArea_MechBoostJump : public UNavArea
+{
+	GENERATED_BODY()
+
+public:
+	/** Path cost, in distance units, charged per point of boost energy a jump spends */
+	static constexpr float CostPerEnergy = 25.f;
+
+	/** The cheapest tier whose energy covers EnergyCost; the top tier when none does */
+	static TSubclassOf<UNavArea_MechBoostJump> GetAreaForEnergyCost(float EnergyCost);
+
+	/** Every tier that spends boost energy, cheapest first */
+	static TConstArrayView<TSubclassOf<UNavArea_MechBoostJump>> GetBoostedTiers();
+
+	float GetEnergyCost() const { return EnergyCost; }
+
+protected:
+	/** Sets the tier's energy and derives the entering cost from it */
+	void SetEnergyCost(float InEnergyCost);
+
+	float EnergyCost = 0.f;
+};
+
+/** Jumps a mech makes without boosting */
+UCLASS()
+class PROJECTMC_API UNavArea_MechBoostJumpFree : public UNavArea_MechBoostJump
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_MechBoostJumpFree();
+};
+
+UCLASS()
+class PROJECTMC_API UNavArea_MechBoostJump25 : public UNavArea_MechBoostJump
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_MechBoostJump25();
+};
+
+UCLASS()
+class PROJECTMC_API UNavArea_MechBoostJump50 : public UNavArea_MechBoostJump
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_MechBoostJump50();
+};
+
+UCLASS()
+class PROJECTMC_API UNavArea_MechBoostJump100 : public UNavArea_MechBoostJump
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_MechBoostJump100();
+};
+
+UCLASS()
+class PROJECTMC_API UNavArea_MechBoostJump200 : public UNavArea_MechBoostJump
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_MechBoostJump200();
+};
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "NavFilter_MechNoBoostJump.generated.h"
+
+/**
+ * Query filter for mechs that can't make boost jumps; excludes every UNavArea_MechBoostJump tier that spends energy
+ */
+UCLASS()
+class PROJECTMC_API UNavFilter_MechNoBoostJump : public UNavigationQueryFilter
+{
+	GENERATED_BODY()
+
+public:
+	UNavFilter_MechNoBoostJump();
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MechBoostEnergy.generated.h"
+
+/**
+ * Boost energy stored as a linear function of time instead of being integrated every frame.
+ * The value is only evaluated when read; changes of rate or spends rebase it at the current time.
+ */
+USTRUCT(BlueprintType)
+struct PROJECTMC_API FMechBoostEnergy
+{
+	GENERATED_BODY()
+
+	/** Energy at BaseTime */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Boost")
+	float BaseEnergy = 0.f;
+
+	/** World time of the last change */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Boost")
+	double BaseTime = 0.0;
+
+	/** Energy per second since BaseTime; negative while boosting */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Boost")
+	float Rate = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Boost")
+	float MaxEnergy = 0.f;
+
+	float Evaluate(double Now) const
+	{
+		return FMath::Clamp(BaseEnergy + Rate * static_cast<float>(Now - BaseTime), 0.f, MaxEnergy);
+	}
+
+	/** Restarts the function at Now with a new rate, keeping the current value */
+	void Rebase(double Now, float NewRate)
+	{
+		BaseEnergy = Evaluate(Now);
+		BaseTime = Now;
+		Rate = NewRate;
+	}
+
+	/** Adds (or with a negative Amount, spends) energy at Now */
+	void Add(double Now, float Amount)
+	{
+		BaseEnergy = FMath::Clamp(Evaluate(Now) + Amount, 0.f, MaxEnergy);
+		BaseTime = Now;
+	}
+
+	/** Seconds from Now until the energy reaches Target at the current rate, or -1 if it never does */
+	float TimeUntil(double Now, float Target) const
+	{
+		const float Current = Evaluate(Now);
+		if (FMath::IsNearlyEqual(Current, Target))
+		{
+			return 0.f;
+		}
+
+		if (Rate == 0.f || (Target - Current) * Rate < 0.f)
+		{
+			return -1.f;
+		}
+
+		return (Target - Current) / Rate;
+	}
+};
@@ -4,20 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "../ProjectMCCharacter.h"
+#include "Characters/MechBoostEnergy.h"
+#include "Loadout/MechLoadout.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
 #include "PlayerMech.generated.h"
 
 class UTimelineComponent;
+class UMechTuningData;
+class UMechMovementComponent;
+enum class EMechTelemetryEvent : uint8;
+enum class EMechDashType : uint8;
 
 /**
  * Player Mech Character with customizable jump behavior
  */
 UCLASS()
-class PROJECTMC_API APlayerMech : public AProjectMCCharacter
+class PROJECTMC_API APlayerMech : public AProjectMCCharacter, public IWorldPartitionStreamingSourceProvider
 {
 	GENERATED_BODY()
 	
 public:
-	APlayerMech();
+	APlayerMech(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 protected:
 	/** Called when jump input is started - can be overridden for custom jump behavior */
@@ -32,16 +39,26 @@ protected:
 
 	void Look(const FInputActionValue& Value);
 
+	virtual void PostInitializeComponents() override;
+
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TrimForDedicatedServer() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	/** Override Jump function for custom mech jump logic */
 	virtual void Jump() override;
 	
+	virtual void OnJumped_Implementation() override;
+
 	/** Override StopJumping function for custom mech jump stop logic */
 	virtual void StopJumping() override;
 
-	virtual void Tick(float DeltaTime) override;
-
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	void StartBoost();
@@ -57,18 +74,62 @@ protected:
 	UFUNCTION()
 	void UpdateTurnDash(float Value);
 
-	UFUNCTION()
-	void UpdateVelocityDamping(float Value);
+public:
+	/** Returns the shared tuning asset, or the class defaults when none is assigned */
+	const UMechTuningData& GetTuning() const;
 
-	UFUNCTION()
-	void FinishedVelocityDamping();
+	UMechMovementComponent* GetMechMovement() const;
+
+	/** Evaluates the boost energy at the current world time */
+	UFUNCTION(BlueprintPure, Category = "Boost")
+	float GetBoostEnergy() const;
+
+	bool IsBoosting() const { return bIsBoosting; }
+
+	/** Switches to another tuning asset and re-applies it, keeping the current boost energy */
+	void SetTuningData(UMechTuningData* NewTuningData);
+
+	/** Swaps one part of the loadout; a complete loadout re-derives the mech's tuning */
+	UFUNCTION(BlueprintCallable, Category = "Loadout")
+	void EquipPart(UMechPartData* Part);
+
+	/** Starts or stops boosting for controllers that don't go through input (AI) */
+	void SetBoostRequested(bool bBoost);
+
+	// IWorldPartitionStreamingSourceProvider interface
+	virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& StreamingSources) const override;
+	virtual UObject* GetStreamingSourceOwner() override { return this; }
 
 private:
-	/** Helper function to perform dash launch with specified velocity multiplier */
-	void PerformDashLaunch(float VelocityMultiplier, bool bConsumeEnergy = false);
-	
-	/** Helper function to clamp character velocity */
-	void ClampCharacterVelocity();
+	/** The assigned tuning asset, or the class default object standing in for it */
+	UMechTuningData* GetTuningAsset() const;
+
+	/** Pushes the shared tuning values onto the movement component and timelines */
+	void ApplyTuning();
+
+	/** Shared tuning for the current loadout on top of the frame tuning, or null if there is none */
+	UMechTuningData* GetLoadoutTuning() const;
+
+	/** Called when the shared tuning asset is edited at runtime */
+	void HandleTuningChanged(const UMechTuningData* ChangedTuning);
+
+	/** Distance the mech is expected to cover within the streaming lookahead, from velocity and remaining boost */
+	float GetPredictedTravelDistance(float Speed) const;
+
+	/** World time the boost energy function is evaluated against */
+	double GetEnergyTime() const;
+
+	/** Switches the energy rate for the current boost state and schedules depletion */
+	void UpdateBoostEnergyRate();
+
+	/** Fires when boost energy runs out while boosting */
+	void HandleBoostDepleted();
+
+	/** Helper function to start a dash with an impulse along Direction */
+	void PerformDashLaunch(const FVector& Direction, float Impulse, EMechDashType DashType, bool bConsumeEnergy = false);
+
+	/** Records a telemetry event for this mech; EnergyAfter and Speed are read from the current state */
+	void RecordTelemetry(EMechTelemetryEvent Event, EMechDashType DashType, float EnergyBefore, float Speed) const;
 	
 	/** Helper function to setup dash state after launch */
 	void SetupPostDashState();
@@ -83,33 +144,20 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech Movement")
 	bool bIsMovementInput = false;
 
-	/** Customizable jump parameters for mech */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech Movement")
-	float MechJumpVelocity = 1200.f;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech Movement")
-	float MechAirControl = 0.8f;
+	/** Shared tuning for this mech frame/loadout */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mech Movement")
+	UMechTuningData* TuningData;
+
+	/** Parts this mech is built from; once every slot is filled, tuning is derived from them */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loadout")
+	FMechLoadout Loadout;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Boost")
 	bool bIsBoosting = false;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boost")
-	float BoostSpeed = 1800.f;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boost")
-	float NormalSpeed = 550.0f;
-
+	/** Boost energy as a function of time; Blueprints read the current value through GetBoostEnergy */
 	UPROPERTY(BlueprintReadOnly, Category = "Boost")
-	float BoostEnergy = 100.f;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boost")
-	float MaxBoostEnergy = 100.f;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boost")
-	float BoostDepleteRate = 25.f;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boost")
-	float BoostRegenRate = 15.f;
+	FMechBoostEnergy BoostEnergyState;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
 	bool bIsValidLeftDash = true;
@@ -132,24 +180,9 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
 	float MoveValueY;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
-	UTimelineComponent* DashCooldownTimeline;
-
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
 	UTimelineComponent* TurnDashTimeline;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
-	UTimelineComponent* VelocityDampingTimeline;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
-	UCurveFloat* DashCooldownCurve;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
-	UCurveFloat* TurnDashCurve;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dash")
-	UCurveFloat* VelocityDampingCurve;
-
 	FRotator StartingControlRotation;
 
 	float TurnLookValueX;
@@ -159,4 +192,11 @@ protected:
 	float LookValueY;
 
 	FTimerHandle DashCooldownTimer;
+
+	FTimerHandle BoostDepletedTimer;
+
+	FDelegateHandle TuningChangedHandle;
+
+	/** Set on the first telemetry record; see RecordTelemetry */
+	mutable uint32 TelemetryMechId = 0;
 };
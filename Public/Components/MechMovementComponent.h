@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "MechMovementComponent.generated.h"
+
+class UMechTuningData;
+
+/** Custom movement modes used with MOVE_Custom */
+UENUM(BlueprintType)
+enum class EMechMovementMode : uint8
+{
+	None,
+	/** Ground boost at BoostSpeed with its own braking */
+	Boost,
+	/** Short fixed-duration burst after a dash input */
+	Dash,
+};
+
+/** Move data sent to the server; carries the requested dash velocity on moves that start a dash */
+struct FMechNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+	FVector DashVelocity = FVector::ZeroVector;
+};
+
+struct FMechNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FMechNetworkMoveDataContainer()
+	{
+		NewMoveData = &MechMoveData[0];
+		PendingMoveData = &MechMoveData[1];
+		OldMoveData = &MechMoveData[2];
+	}
+
+private:
+	FMechNetworkMoveData MechMoveData[3];
+};
+
+/**
+ * Character movement for mechs. Boosting and dashing run as custom movement modes with their
+ * own integration, braking and a small per-step sweep budget, instead of rewriting walking
+ * parameters and clamping launched velocities after the fact.
+ */
+UCLASS()
+class PROJECTMC_API UMechMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMechMovementComponent();
+
+	/** Tuning is owned by the mech (which keeps it referenced); this is just a cached view */
+	void SetTuning(const UMechTuningData* InTuning) { Tuning = InTuning; }
+
+	void SetWantsToBoost(bool bInWantsToBoost) { bWantsToBoost = bInWantsToBoost; }
+
+	bool WantsToBoost() const { return bWantsToBoost; }
+
+	/** Drops falling braking until the next landing so a solved jump arc flies as planned */
+	void SetBoostJumping(bool bInBoostJumping) { bBoostJumping = bInBoostJumping; }
+
+	/**
+	 * Requests a dash at DashVelocity, limited to the tuned dash speed; returns true if the limit was hit.
+	 * Dash mode starts in the next movement update so the request travels with the saved move.
+	 */
+	bool StartDash(const FVector& DashVelocity);
+
+	/** Old dash path kept for cost comparisons: launches, then box-clamps once the launch applies. Not predicted. */
+	bool LaunchDashLegacy(const FVector& DashVelocity);
+
+	bool WantsToDash() const { return bWantsToDash; }
+
+	UFUNCTION(BlueprintPure, Category = "Mech Movement")
+	bool IsBoostMoving() const { return IsCustomMovementMode(static_cast<uint8>(EMechMovementMode::Boost)); }
+
+	UFUNCTION(BlueprintPure, Category = "Mech Movement")
+	bool IsDashing() const { return IsCustomMovementMode(static_cast<uint8>(EMechMovementMode::Dash)); }
+
+	//~ UCharacterMovementComponent interface
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual float GetMaxSpeed() const override;
+	virtual float GetMaxBrakingDeceleration() const override;
+	virtual bool IsMovingOnGround() const override;
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	virtual bool HandlePendingLaunch() override;
+
+protected:
+	virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+	virtual void SetPostLandedPhysics(const FHitResult& Hit) override;
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+
+	void PhysBoost(float DeltaTime, int32 Iterations);
+
+	void PhysDash(float DeltaTime, int32 Iterations);
+
+	/** Switches to dash mode with the pending dash velocity */
+	void EnterDash();
+
+	/** Scales DashVelocity down to the dash speed limit; returns true if it had to */
+	bool LimitDashVelocity(FVector& DashVelocity) const;
+
+	/** Moves by Delta, sliding or stepping up on a blocking hit only while MaxSweeps allows */
+	void MoveWithSweepBudget(const FVector& Delta, int32 MaxSweeps, bool bAllowStepUp, FHitResult& OutHit);
+
+	/** Leaves a custom mode for walking, boosting or falling depending on the floor */
+	void ExitToGroundOrAir(float RemainingTime, int32 Iterations);
+
+public:
+	/** Sweeps per boost step: 1 stops at the first blocking hit, 2 also slides or steps up once */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech Movement", meta = (ClampMin = "1", ClampMax = "2"))
+	int32 MaxBoostSweeps = 2;
+
+	/** Sweeps per dash step: 1 stops at the first blocking hit, 2 also slides or steps up once */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mech Movement", meta = (ClampMin = "1", ClampMax = "2"))
+	int32 MaxDashSweeps = 2;
+
+private:
+	const UMechTuningData& GetTuning() const;
+
+	const UMechTuningData* Tuning = nullptr;
+
+	uint8 bWantsToBoost : 1;
+
+	uint8 bBoostJumping : 1;
+
+	uint8 bWantsToDash : 1;
+
+	/** Set by LaunchDashLegacy so the launch is clamped once it has been applied */
+	uint8 bClampPendingLaunch : 1;
+
+	/** Dash velocity requested by StartDash, or received from the client's move */
+	FVector PendingDashVelocity = FVector::ZeroVector;
+
+	float DashTimeRemaining = 0.f;
+
+	FMechNetworkMoveDataContainer MechMoveDataContainer;
+
+	friend class FSavedMove_Mech;
+};
@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MechTuningData.generated.h"
+
+class UCurveFloat;
+class UMechTuningData;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMechTuningChanged, const UMechTuningData*);
+
+/**
+ * Movement, boost and dash tuning for one mech frame/loadout.
+ * A single asset is shared by pointer across every mech using that loadout and is treated as
+ * read-only by gameplay code. Edits made in the editor (or through mc.Mech.Tune) are pushed to
+ * every mech referencing the asset via OnTuningChanged.
+ */
+UCLASS(BlueprintType)
+class PROJECTMC_API UMechTuningData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	virtual void PostInitProperties() override;
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Recomputes derived values and notifies every mech using this asset */
+	UFUNCTION(BlueprintCallable, Category = "Mech Tuning")
+	void NotifyTuningChanged();
+
+	/** Broadcast after derived values have been recomputed */
+	FOnMechTuningChanged OnTuningChanged;
+
+private:
+	/** Precomputes values that would otherwise be derived on every read */
+	void RecomputeDerivedValues();
+
+public:
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mech Movement")
+	float MechJumpVelocity = 1200.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mech Movement")
+	float MechAirControl = 0.8f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mech Movement")
+	float GravityScale = 1.5f;
+
+	/** Yaw rotation rate used when orienting to movement */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mech Movement")
+	float YawRotationRate = 500.f;
+
+	/** Friction while walking; boost and dash modes use their own braking */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mech Movement", meta = (ClampMin = "0.0"))
+	float GroundFriction = 8.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mech Movement", meta = (ClampMin = "0.0"))
+	float BrakingFrictionFactor = 2.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Boost")
+	float BoostSpeed = 1800.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Boost")
+	float NormalSpeed = 550.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Boost", meta = (ClampMin = "0.0"))
+	float MaxBoostEnergy = 100.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Boost", meta = (ClampMin = "0.0"))
+	float BoostDepleteRate = 25.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Boost", meta = (ClampMin = "0.0"))
+	float BoostRegenRate = 15.f;
+
+	/** Friction in the boost movement mode; low values let the mech skate between inputs */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Boost", meta = (ClampMin = "0.0"))
+	float BoostFriction = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Boost", meta = (ClampMin = "0.0"))
+	float BoostBrakingDeceleration = 1200.f;
+
+	/** Energy consumed by a forward/back dash or a reversing side dash */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float DashEnergyCost = 10.f;
+
+	/** Dashing is not allowed at or below this energy */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float MinDashEnergy = 10.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float ForwardDashSpeed = 15000.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float SideDashSpeed = 15000.f;
+
+	/** Side dash impulse used when reversing out of sideways momentum */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float SideDashReverseSpeed = 12000.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float DashLiftVelocity = 20.f;
+
+	/** Maximum horizontal dash speed; the dash impulse plus current velocity is limited to this magnitude */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float DashVelocityLimit = 2000.f;
+
+	/** Seconds spent in the dash movement mode */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash", meta = (ClampMin = "0.0"))
+	float DashDuration = 0.35f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash", meta = (ClampMin = "0.0"))
+	float DashBrakingDeceleration = 3000.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float DashCooldown = 1.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	float TurnDashAngle = 90.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dash")
+	UCurveFloat* TurnDashCurve;
+
+	/** Seconds of travel the predictive streaming source looks ahead along current velocity */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float StreamingLookaheadSeconds = 2.f;
+
+	/** Below this speed no predictive source is added */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float StreamingMinSpeed = 300.f;
+
+	/** Upper bound on how far ahead cells are requested */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float StreamingMaxLookaheadDistance = 25600.f;
+
+	/** Distance between the shapes placed along the predicted path */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "1.0"))
+	float StreamingShapeSpacing = 6400.f;
+
+	/** Scale on each grid's loading range for the shapes along the predicted path */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float StreamingShapeRangeScale = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 StreamingMaxShapes = 4;
+
+	/** Above this speed the predicted path is streamed at high priority */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Streaming")
+	float StreamingHighPrioritySpeed = 1200.f;
+
+	/** Weight at which part thrust values translate one-to-one into speeds */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Loadout", meta = (ClampMin = "1.0"))
+	float LoadoutReferenceWeight = 10000.f;
+
+	/** Regen floor for loadouts whose parts draw more than the generator supplies */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Loadout", meta = (ClampMin = "0.0"))
+	float LoadoutMinRegenRate = 2.f;
+
+	/** For tuning built from a loadout, the frame tuning it was derived from */
+	UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = "Derived")
+	UMechTuningData* LoadoutBase = nullptr;
+
+	UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = "Derived")
+	float DashVelocityLimitSquared = 0.f;
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Base for console-started runs that tick for a fixed time, time their frames and log the
+ * results. Only one run goes at a time. Meant for headless runs, e.g.
+ *   -game -nullrhi -ExecCmds="<command> <args>" -<ExitParam>
+ * where the exit param makes the process quit once the run finishes.
+ */
+class PROJECTMC_API FMechTimedRun
+{
+public:
+	/** Frames longer than this count as hitches */
+	static constexpr float HitchSeconds = 0.05f;
+
+	virtual ~FMechTimedRun();
+
+	bool IsFinished() const { return bFinished; }
+
+	/** False, with a warning naming Command, while another run is still going */
+	static bool CanStart(const TCHAR* Command);
+
+	/** Makes Run the active run; it starts ticking on the next frame */
+	static void Start(TUniquePtr<FMechTimedRun> Run);
+
+protected:
+	FMechTimedRun(const TCHAR* InExitParam, float InDuration);
+
+	/** Advances the run by a frame; returning false finishes it early */
+	virtual bool TickRun(float DeltaTime) = 0;
+
+	/** Logs the run's results and removes whatever it spawned */
+	virtual void FinishRun() = 0;
+
+	/** Logs frame count, average and worst frame time and hitches */
+	void LogFrameStats() const;
+
+	float GetElapsed() const { return Elapsed; }
+	int32 GetNumFrames() const { return NumFrames; }
+
+	float GetAverageFrameSeconds() const { return NumFrames > 0 ? Elapsed / NumFrames : 0.f; }
+
+private:
+	bool Tick(float DeltaTime);
+
+	void Finish();
+
+	const TCHAR* ExitParam;
+	float Duration;
+	float Elapsed = 0.f;
+	float WorstFrameSeconds = 0.f;
+	int32 NumFrames = 0;
+	int32 NumHitches = 0;
+	bool bStarted = false;
+	bool bFinished = false;
+	FTSTicker::FDelegateHandle TickHandle;
+};
+
+#endif
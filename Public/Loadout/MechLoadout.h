@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Loadout/MechPartData.h"
+#include "MechLoadout.generated.h"
+
+class UMechTuningData;
+
+/**
+ * A mech assembled from one part per slot. Part stats are aggregated as they are equipped, and
+ * the derived movement values are closed-form functions of those totals.
+ */
+USTRUCT(BlueprintType)
+struct PROJECTMC_API FMechLoadout
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loadout")
+	FString BuildName;
+
+	/** Indexed by EMechPartSlot; after writing it directly, call RefreshStats */
+	UPROPERTY(EditAnywhere, Category = "Loadout")
+	UMechPartData* Parts[NumMechPartSlots] = {};
+
+	UMechPartData* GetPart(EMechPartSlot Slot) const { return Parts[static_cast<int32>(Slot)]; }
+
+	bool IsComplete() const;
+
+	/** Equips Part in its slot, updating the totals by the difference between the old and new part */
+	void SetPart(UMechPartData* Part);
+
+	void ClearPart(EMechPartSlot Slot);
+
+	/** Totals across all equipped parts */
+	const FMechPartStats& GetStats() const { return Stats; }
+
+	/** Rebuilds the totals from the part array after it was written directly (editor edits, loading) */
+	void RefreshStats();
+
+	void PostSerialize(const FArchive& Ar);
+
+	/** Writes the loadout-driven values onto Out, taking everything else from Base */
+	void ApplyToTuning(const UMechTuningData& Base, UMechTuningData& Out) const;
+
+	/** True for tuning properties that ApplyToTuning overwrites */
+	static bool IsLoadoutDriven(const FProperty& Property);
+
+private:
+	/** Totals kept up to date by SetPart and ClearPart; an empty loadout starts at zero */
+	FMechPartStats Stats;
+};
+
+template<>
+struct TStructOpsTypeTraits<FMechLoadout> : public TStructOpsTypeTraitsBase2<FMechLoadout>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
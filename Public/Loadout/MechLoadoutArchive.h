@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/PrimaryAssetId.h"
+#include "Loadout/MechPartData.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** A saved build as stored on disk: a name and one part id per slot */
+struct FMechSavedBuild
+{
+	FString Name;
+	FPrimaryAssetId Parts[NumMechPartSlots];
+};
+
+/**
+ * Compact, versioned binary file of saved builds, little endian:
+ *
+ *   header      FMechLoadoutFileHeader
+ *   part table  NumParts x (uint16 length, UTF-8 primary asset id)
+ *   name blob   null-terminated UTF-8 build names, padded to 4 bytes
+ *   builds      NumBuilds x FMechLoadoutBuildRecord (16 bytes each)
+ *
+ * Parts are stored once and builds refer to them by index, so a build costs 16 bytes plus its name.
+ */
+namespace MechLoadoutArchive
+{
+	constexpr uint32 Magic = 0x444C434D; // "MCLD"
+	constexpr uint16 CurrentVersion = 1;
+	constexpr uint16 NoPart = 0xFFFF;
+
+	bool Save(const FString& Filename, TConstArrayView<FMechSavedBuild> Builds);
+}
+
+struct FMechLoadoutFileHeader
+{
+	uint32 Magic;
+	uint16 Version;
+	uint16 NumSlots;
+	uint32 NumParts;
+	uint32 PartTableSize;
+	uint32 NameBlobSize;
+	uint32 NumBuilds;
+};
+
+struct FMechLoadoutBuildRecord
+{
+	uint16 PartIndices[NumMechPartSlots];
+	uint32 NameOffset;
+};
+
+static_assert(sizeof(FMechLoadoutFileHeader) == 24, "Loadout file header layout changed; bump MechLoadoutArchive::CurrentVersion");
+static_assert(sizeof(FMechLoadoutBuildRecord) == 16, "Loadout build record layout changed; bump MechLoadoutArchive::CurrentVersion");
+
+/**
+ * Reads a loadout file through a memory mapping (or a plain read where mapping isn't supported).
+ * Only the header and part table are decoded on open; builds are decoded when asked for.
+ */
+class PROJECTMC_API FMechLoadoutArchiveReader
+{
+public:
+	FMechLoadoutArchiveReader();
+	~FMechLoadoutArchiveReader();
+
+	bool Open(const FString& Filename);
+
+	void Close();
+
+	int32 NumBuilds() const { return static_cast<int32>(NumBuildRecords); }
+
+	FString GetBuildName(int32 Index) const;
+
+	bool ReadBuild(int32 Index, FMechSavedBuild& OutBuild) const;
+
+private:
+	bool Parse();
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	TArray<uint8> FallbackData;
+
+	const uint8* Data = nullptr;
+
+	int64 DataSize = 0;
+
+	TArray<FPrimaryAssetId> PartIds;
+
+	const ANSICHAR* NameBlob = nullptr;
+
+	uint32 NameBlobSize = 0;
+
+	const FMechLoadoutBuildRecord* BuildRecords = nullptr;
+
+	uint32 NumBuildRecords = 0;
+};
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Loadout/MechLoadout.h"
+#include "Loadout/MechLoadoutArchive.h"
+#include "MechLoadoutSubsystem.generated.h"
+
+class UMechTuningData;
+
+/** Tuning derived from one base asset and one set of parts */
+USTRUCT()
+struct FMechDerivedTuning
+{
+	GENERATED_BODY()
+
+	/** Held weakly so a derived tuning only lives while some mech is equipped with it */
+	UPROPERTY()
+	TWeakObjectPtr<UMechTuningData> Tuning;
+
+	/** Keeps the parts alive until the entry is pruned, so its key can't match a recycled address */
+	UPROPERTY()
+	FMechLoadout Loadout;
+};
+
+/** Base asset plus the part in every slot; identical builds share one derived tuning */
+struct FMechLoadoutTuningKey
+{
+	const UMechTuningData* Base = nullptr;
+	const UMechPartData* Parts[NumMechPartSlots] = {};
+
+	bool operator==(const FMechLoadoutTuningKey& Other) const
+	{
+		return Base == Other.Base && FMemory::Memcmp(Parts, Other.Parts, sizeof(Parts)) == 0;
+	}
+
+	friend uint32 GetTypeHash(const FMechLoadoutTuningKey& Key)
+	{
+		uint32 Hash = GetTypeHash(Key.Base);
+		for (const UMechPartData* Part : Key.Parts)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Part));
+		}
+		return Hash;
+	}
+};
+
+/**
+ * Owns tuning derived from loadouts and the player's saved builds.
+ * Mechs with the same base and parts share one derived tuning asset, and edits to a base asset
+ * are patched onto every tuning derived from it. Only builds some mech is equipped with stay
+ * cached; tunings for combinations passed through while swapping parts are collected. Saved builds live in a single mapped file and
+ * are only decoded when a build is read.
+ */
+UCLASS()
+class PROJECTMC_API UMechLoadoutSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Returns the shared tuning for Loadout built on Base, deriving it on first use */
+	UMechTuningData* GetTuningForLoadout(const FMechLoadout& Loadout, UMechTuningData* Base);
+
+	/** Replaces the saved builds file with Builds */
+	UFUNCTION(BlueprintCallable, Category = "Loadout")
+	bool SaveBuilds(const TArray<FMechLoadout>& Builds);
+
+	UFUNCTION(BlueprintPure, Category = "Loadout")
+	int32 GetNumSavedBuilds() const;
+
+	UFUNCTION(BlueprintPure, Category = "Loadout")
+	FString GetSavedBuildName(int32 Index) const;
+
+	/** Decodes one saved build and loads its parts; parts that no longer exist are left empty */
+	UFUNCTION(BlueprintCallable, Category = "Loadout")
+	bool LoadSavedBuild(int32 Index, FMechLoadout& OutLoadout) const;
+
+	static FString GetSavedBuildsFilename();
+
+private:
+	static FMechLoadoutTuningKey MakeKey(const FMechLoadout& Loadout, const UMechTuningData* Base);
+
+	/** Copies the authored values of Base that differ on Derived and applies the loadout on top */
+	static void PatchTuning(const UMechTuningData& Base, const FMechLoadout& Loadout, UMechTuningData& Derived);
+
+	void HandleBaseTuningChanged(const UMechTuningData* Base);
+
+	/** Drops entries whose tuning was collected and unsubscribes from bases with none left */
+	void PruneDerivedTunings();
+
+	UPROPERTY()
+	TArray<FMechDerivedTuning> DerivedTunings;
+
+	/** Index into DerivedTunings */
+	TMap<FMechLoadoutTuningKey, int32> DerivedTuningLookup;
+
+	/** Bases whose OnTuningChanged we are subscribed to */
+	TSet<TWeakObjectPtr<UMechTuningData>> WatchedBases;
+
+	FMechLoadoutArchiveReader SavedBuilds;
+};
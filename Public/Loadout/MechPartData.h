@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MechPartData.generated.h"
+
+UENUM(BlueprintType)
+enum class EMechPartSlot : uint8
+{
+	Head,
+	Core,
+	Arms,
+	Legs,
+	Booster,
+	Generator,
+	Count UMETA(Hidden),
+};
+
+constexpr int32 NumMechPartSlots = static_cast<int32>(EMechPartSlot::Count);
+
+/**
+ * Stats a part contributes to a loadout. Loadout totals are plain sums, so swapping one part is
+ * a subtract and an add rather than a walk over every slot.
+ */
+USTRUCT(BlueprintType)
+struct PROJECTMC_API FMechPartStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float Weight = 0.f;
+
+	/** Weight the legs carry before the mech counts as overweight */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float LoadCapacity = 0.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float EnergyCapacity = 0.f;
+
+	/** Energy per second the generator supplies */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float EnergyOutput = 0.f;
+
+	/** Energy per second the part draws just by being equipped */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float EnergyDrain = 0.f;
+
+	/** Boost speed at the reference weight */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float BoostThrust = 0.f;
+
+	/** Energy per second spent while boosting */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float BoostConsumption = 0.f;
+
+	/** Jump velocity at the reference weight */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float JumpThrust = 0.f;
+
+	/** Dash impulse at the reference weight */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float DashThrust = 0.f;
+
+	FMechPartStats& operator+=(const FMechPartStats& Other);
+
+	FMechPartStats& operator-=(const FMechPartStats& Other);
+};
+
+/**
+ * One mech part (head, core, arms, legs, booster or generator)
+ */
+UCLASS(BlueprintType)
+class PROJECTMC_API UMechPartData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Part")
+	EMechPartSlot Slot = EMechPartSlot::Head;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Part")
+	FText DisplayName;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Part")
+	FMechPartStats Stats;
+};
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MechTelemetry.generated.h"
+
+UENUM()
+enum class EMechTelemetryEvent : uint8
+{
+	Dash,
+	/** The dash velocity was limited by DashVelocityLimit; Speed is the requested speed */
+	DashClamped,
+	BoostDepleted,
+	Jump,
+	Count UMETA(Hidden),
+};
+
+UENUM()
+enum class EMechDashType : uint8
+{
+	None,
+	Forward,
+	Back,
+	Side,
+	/** Side dash out of sideways momentum, which costs energy */
+	SideReverse,
+	Turn,
+	Count UMETA(Hidden),
+};
+
+/** One telemetry event. Copied by value into the rings, so it stays a small POD */
+struct FMechTelemetryRecord
+{
+	/** World time in seconds */
+	double Time = 0.0;
+
+	/** MechTelemetry::MakeMechId of a name that identifies the mech across sessions */
+	uint32 MechId = 0;
+
+	EMechTelemetryEvent Event = EMechTelemetryEvent::Dash;
+
+	EMechDashType DashType = EMechDashType::None;
+
+	float EnergyBefore = 0.f;
+
+	float EnergyAfter = 0.f;
+
+	/** Horizontal speed at the time of the event */
+	float Speed = 0.f;
+};
+
+/**
+ * Gameplay telemetry for balancing. Record() copies the event into a ring owned by the calling
+ * thread without taking a lock; a background writer drains the rings and appends compressed,
+ * column-major blocks to the session file. When a ring is full the event is dropped and counted.
+ *
+ * File layout, little endian:
+ *
+ *   header  FMechTelemetryFileHeader
+ *   blocks  FMechTelemetryBlockHeader followed by CompressedSize bytes of zlib data, which holds
+ *           the columns Time, MechId, EnergyBefore, EnergyAfter, Speed, Event, DashType in turn
+ */
+namespace MechTelemetry
+{
+	constexpr uint32 FileMagic = 0x4C54434D; // "MCTL"
+	constexpr uint16 CurrentVersion = 1;
+
+	/** Lets callers skip gathering values for a record nobody will write */
+	PROJECTMC_API bool IsActive();
+
+	PROJECTMC_API void Record(const FMechTelemetryRecord& Record);
+
+	/** Starts the writer thread on a new file; only one session runs at a time */
+	PROJECTMC_API bool StartSession(const FString& Filename);
+
+	/** Writes out everything recorded so far and stops the writer thread */
+	PROJECTMC_API void StopSession();
+
+	PROJECTMC_API FString GetDefaultSessionFilename();
+
+	/** Id recorded for a mech known by StableName; the same name gives the same id in every session */
+	inline uint32 MakeMechId(const FString& StableName)
+	{
+		return GetTypeHash(StableName);
+	}
+}
+
+struct FMechTelemetryFileHeader
+{
+	uint32 Magic;
+	uint16 Version;
+	uint16 Reserved;
+};
+
+struct FMechTelemetryBlockHeader
+{
+	uint32 NumRecords;
+	uint32 UncompressedSize;
+	uint32 CompressedSize;
+	/** Events dropped on full rings since the previous block */
+	uint32 NumDropped;
+};
+
+static_assert(sizeof(FMechTelemetryFileHeader) == 8, "Telemetry file header layout changed; bump MechTelemetry::CurrentVersion");
+static_assert(sizeof(FMechTelemetryBlockHeader) == 16, "Telemetry block header layout changed; bump MechTelemetry::CurrentVersion");
+
+/** Column pointers into one decompressed block */
+struct FMechTelemetryBlock
+{
+	int32 NumRecords = 0;
+	uint32 NumDropped = 0;
+	const double* Time = nullptr;
+	const uint32* MechId = nullptr;
+	const float* EnergyBefore = nullptr;
+	const float* EnergyAfter = nullptr;
+	const float* Speed = nullptr;
+	const EMechTelemetryEvent* Event = nullptr;
+	const EMechDashType* DashType = nullptr;
+};
+
+/** Reads a session file one block at a time */
+class PROJECTMC_API FMechTelemetryFileReader
+{
+public:
+	bool Open(const FString& Filename);
+
+	/** Decompresses the next block; its column pointers stay valid until the next call */
+	bool ReadNextBlock(FMechTelemetryBlock& OutBlock);
+
+private:
+	TArray<uint8> FileData;
+
+	int64 Cursor = 0;
+
+	TArray<uint8> BlockData;
+};
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MechTelemetryQueryCommandlet.generated.h"
+
+/**
+ * Summarises telemetry files offline.
+ * Usage: -run=MechTelemetryQuery [-File=<path>] [-Mech=<id, actor name or player net id>]
+ * Without -File every file in Saved/Telemetry is read.
+ */
+UCLASS()
+class UMechTelemetryQueryCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMechTelemetryQueryCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
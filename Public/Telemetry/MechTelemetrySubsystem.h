@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "MechTelemetrySubsystem.generated.h"
+
+/** Records a telemetry session for the lifetime of the game instance when mc.Telemetry is enabled */
+UCLASS()
+class PROJECTMC_API UMechTelemetrySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+private:
+	bool bOwnsSession = false;
+};